@@ -9,6 +9,7 @@ struct Texture {
     int       height;  // real image height
     int       stride;  // padded row width (power-of-two)
     uint32_t* data;    // pixels (aligned, linear, not swizzled)
+    bool      ownsData; // false for atlas sub-rects: texFree() leaves the pixels alone
 };
 
 // Load a PNG from a full PSP path (ms0:/... or ef0:/...)
@@ -16,6 +17,11 @@ struct Texture {
 Texture* texLoadPNG(const char* fullPath);
 Texture* texLoadPNGFromMemory(const unsigned char* data, int len);
 
+// Wrap a sub-rect of a shared RGBA8888 atlas. x must be a multiple of 4 so
+// rows stay 16-byte aligned; stride becomes the atlas width, so the regular
+// draw helpers sample just this rect. The atlas must outlive the Texture.
+Texture* texFromAtlas(uint32_t* atlas, int atlasW, int x, int y, int w, int h);
+
 // Free both the pixel buffer and the Texture object.
 void texFree(Texture* t);
 
@@ -0,0 +1,99 @@
+#ifndef KFE_CAT_PLAN_H
+#define KFE_CAT_PLAN_H
+
+#include <stdio.h>
+#include <strings.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "kfe_fold.h"
+
+// ---- category rename planner ----
+// Works out every rename/merge needed to bring category folders to their
+// wanted names from listings the caller already made. No I/O, so the host
+// test in tests/ drives it directly. Renames whose target is still held by
+// another pending rename wait for it; a cycle (folders trading names) is
+// broken through a temporary name.
+struct KfeCatPlanStep {
+    enum Kind { Rename, Merge } kind;
+    std::string absRoot, from, to;
+};
+struct KfeCatRootListing {
+    std::string absRoot;
+    std::vector<std::string> subs;    // immediate subfolders, on-disk order
+    std::vector<std::string> bases;   // folded category base per sub; "" = game folder, never a category
+};
+typedef std::vector<std::pair<std::string, std::string>> KfeCatWantList;   // (base, wanted folder name)
+
+static void kfePlanCategoryRenames(const std::vector<KfeCatRootListing>& roots, const KfeCatWantList& wants,
+                                   std::vector<KfeCatPlanStep>& plan) {
+    std::unordered_map<std::string, size_t> wantIdx;   // folded base -> index in wants
+    for (size_t w = 0; w < wants.size(); ++w) wantIdx.emplace(kfeFoldCase(wants[w].first.c_str()), w);
+
+    for (const auto& L : roots) {
+        std::vector<std::vector<std::string>> matches(wants.size());
+        std::unordered_set<std::string> live;          // folded names present right now
+        std::unordered_set<std::string> claimed;       // folded names that are some base's variant
+        for (size_t i = 0; i < L.subs.size(); ++i) {
+            live.insert(kfeFoldCase(L.subs[i].c_str()));
+            if (i >= L.bases.size() || L.bases[i].empty()) continue;
+            auto it = wantIdx.find(L.bases[i]);
+            if (it == wantIdx.end()) continue;
+            matches[it->second].push_back(L.subs[i]);
+            claimed.insert(kfeFoldCase(L.subs[i].c_str()));
+        }
+
+        std::vector<KfeCatPlanStep> renames, merges;
+        for (size_t w = 0; w < wants.size(); ++w) {
+            const auto& m = matches[w];
+            if (m.empty()) continue;
+            const std::string& want = wants[w].second;
+            const std::string wantKey = kfeFoldCase(want.c_str());
+
+            bool haveWant = false;
+            for (const auto& s : m) if (!strcasecmp(s.c_str(), want.c_str())) { haveWant = true; break; }
+            // An unrelated folder already named 'want' is merged into, as before;
+            // one that is another base's variant is about to move away.
+            if (!haveWant && live.count(wantKey) && !claimed.count(wantKey)) haveWant = true;
+
+            size_t firstMerge = 0;
+            if (!haveWant) {
+                renames.push_back({KfeCatPlanStep::Rename, L.absRoot, m[0], want});
+                firstMerge = 1;
+            }
+            for (size_t i = firstMerge; i < m.size(); ++i) {
+                if (!strcasecmp(m[i].c_str(), want.c_str())) continue;
+                merges.push_back({KfeCatPlanStep::Merge, L.absRoot, m[i], want});
+            }
+        }
+
+        // Order renames so no target is occupied when its turn comes.
+        int tmpSeq = 0;
+        while (!renames.empty()) {
+            bool progressed = false;
+            for (size_t i = 0; i < renames.size(); ) {
+                const std::string toKey = kfeFoldCase(renames[i].to.c_str());
+                if (live.count(toKey)) { ++i; continue; }
+                live.erase(kfeFoldCase(renames[i].from.c_str()));
+                live.insert(toKey);
+                plan.push_back(renames[i]);
+                renames.erase(renames.begin() + i);
+                progressed = true;
+            }
+            if (progressed) continue;
+
+            char tmp[32];
+            do { snprintf(tmp, sizeof(tmp), "_KFE_TMP%02d", tmpSeq++); } while (live.count(kfeFoldCase(tmp)));
+            plan.push_back({KfeCatPlanStep::Rename, L.absRoot, renames[0].from, tmp});
+            live.erase(kfeFoldCase(renames[0].from.c_str()));
+            live.insert(kfeFoldCase(tmp));
+            renames[0].from = tmp;
+        }
+        plan.insert(plan.end(), merges.begin(), merges.end());
+    }
+}
+
+#endif // KFE_CAT_PLAN_H
@@ -0,0 +1,15 @@
+#ifndef KFE_FOLD_H
+#define KFE_FOLD_H
+
+#include <string>
+
+// ASCII-only lower-casing used for every case-insensitive name key (FAT
+// compares names the same way). Plain C++ so host tests can use it too.
+static inline char toLowerC(char c){ return (c>='A'&&c<='Z')? (c-'A'+'a') : c; }
+static inline std::string kfeFoldCase(const char* s) {
+    std::string out; if (!s) return out;
+    for (; *s; ++s) { char c = *s; out.push_back((c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c); }
+    return out;
+}
+
+#endif // KFE_FOLD_H
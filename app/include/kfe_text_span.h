@@ -0,0 +1,114 @@
+#ifndef KFE_TEXT_SPAN_H
+#define KFE_TEXT_SPAN_H
+
+#include <string.h>
+#include <string>
+
+#include "kfe_fold.h"
+
+// ---------------------------------------------------------------
+// Text spans: non-owning slices of one read buffer. The gclite filter,
+// ARK PLUGINS.txt and PRO VSH.txt parsers walk lines/columns with these
+// and only build a std::string for values they actually keep. Plain C++;
+// tests/text_span_test.cpp drives them on the host.
+// ---------------------------------------------------------------
+struct KfeTextSpan {
+    const char* p = nullptr;
+    size_t n = 0;
+    KfeTextSpan() {}
+    KfeTextSpan(const char* s, size_t len) : p(s), n(len) {}
+    explicit KfeTextSpan(const std::string& s) : p(s.data()), n(s.size()) {}
+    bool empty() const { return n == 0; }
+    char operator[](size_t i) const { return p[i]; }
+    std::string str() const { return std::string(p, n); }
+    KfeTextSpan sub(size_t a, size_t len = std::string::npos) const {
+        if (a > n) a = n;
+        if (len > n - a) len = n - a;
+        return KfeTextSpan(p + a, len);
+    }
+    size_t find(char c, size_t from = 0) const {
+        for (size_t i = from; i < n; ++i) if (p[i] == c) return i;
+        return std::string::npos;
+    }
+};
+
+static inline bool kfeSpanIsBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static KfeTextSpan kfeSpanTrim(KfeTextSpan s) {
+    size_t a = 0, b = s.n;
+    while (a < b && kfeSpanIsBlank(s.p[a])) ++a;
+    while (b > a && kfeSpanIsBlank(s.p[b-1])) --b;
+    return KfeTextSpan(s.p + a, b - a);
+}
+
+static bool kfeSpanEqNoCase(KfeTextSpan s, const char* lit) {
+    size_t m = strlen(lit);
+    if (m != s.n) return false;
+    for (size_t i = 0; i < m; ++i) if (toLowerC(s.p[i]) != toLowerC(lit[i])) return false;
+    return true;
+}
+
+static bool kfeSpanStartsNoCase(KfeTextSpan s, const char* lit) {
+    size_t m = strlen(lit);
+    if (m > s.n) return false;
+    for (size_t i = 0; i < m; ++i) if (toLowerC(s.p[i]) != toLowerC(lit[i])) return false;
+    return true;
+}
+
+static bool kfeSpanContainsNoCase(KfeTextSpan s, const char* lit) {
+    size_t m = strlen(lit);
+    if (m == 0) return true;
+    for (size_t i = 0; i + m <= s.n; ++i) {
+        if (kfeSpanStartsNoCase(KfeTextSpan(s.p + i, s.n - i), lit)) return true;
+    }
+    return false;
+}
+
+// Yields each line of a buffer without its terminator; "\r\n", "\r" and "\n"
+// all end a line. The last line is always yielded, even when empty.
+struct KfeLineCursor {
+    KfeTextSpan text;
+    size_t pos = 0;
+    bool done = false;
+    explicit KfeLineCursor(KfeTextSpan t) : text(t) {}
+    explicit KfeLineCursor(const std::string& t) : text(t) {}
+    bool next(KfeTextSpan& line) {
+        if (done) return false;
+        size_t s = pos;
+        while (pos < text.n && text.p[pos] != '\n' && text.p[pos] != '\r') ++pos;
+        line = KfeTextSpan(text.p + s, pos - s);
+        if (pos >= text.n) { done = true; return true; }
+        if (text.p[pos] == '\r' && pos + 1 < text.n && text.p[pos+1] == '\n') ++pos;
+        ++pos;
+        return true;
+    }
+};
+
+// Splits a line into trimmed fields. With sep != 0 it behaves like the CSV
+// column split (a trailing separator yields one empty field); with sep == 0
+// it yields whitespace-separated words and never an empty one.
+struct KfeFieldCursor {
+    KfeTextSpan text;
+    char sep;
+    size_t pos = 0;
+    bool done = false;
+    KfeFieldCursor(KfeTextSpan t, char separator) : text(t), sep(separator) {}
+    bool next(KfeTextSpan& field) {
+        if (done) return false;
+        if (sep == 0) {
+            while (pos < text.n && kfeSpanIsBlank(text.p[pos])) ++pos;
+            if (pos >= text.n) { done = true; return false; }
+            size_t s = pos;
+            while (pos < text.n && !kfeSpanIsBlank(text.p[pos])) ++pos;
+            field = KfeTextSpan(text.p + s, pos - s);
+            return true;
+        }
+        size_t s = pos;
+        while (pos < text.n && text.p[pos] != sep) ++pos;
+        field = kfeSpanTrim(KfeTextSpan(text.p + s, pos - s));
+        if (pos >= text.n) done = true; else ++pos;
+        return true;
+    }
+};
+
+#endif // KFE_TEXT_SPAN_H
@@ -0,0 +1,78 @@
+#ifndef KFE_UI_PACK_H
+#define KFE_UI_PACK_H
+
+#include <stdint.h>
+
+// resources/ui_pack.bin: every UI texture in one RGBA8888 atlas plus a rect
+// table, built on the host by tools/mkuipack (see the Makefile) and read by
+// the app in a single sceIoRead. Shared by both sides, so plain C++ only.
+//
+// Layout (little-endian, like the PSP):
+//   KfeUiPackHeader
+//   KfeUiPackRect[count]        same order as KFE_UI_TEXTURES
+//   pad to dataOffset (64-byte aligned)
+//   atlasW * atlasH RGBA8888 pixels
+//
+// Each rect records the byte size of the PNG it was built from. A loose PNG
+// in resources/ whose size differs overrides that entry, so themers keep
+// replacing individual PNGs without rebuilding the pack.
+
+// X(file under resources/, texture slot, needed for the first frame)
+// Priority order: critical set first, then roughly the order the UI needs them.
+#define KFE_UI_TEXTURES(X) \
+    X("bkg.png",                    backgroundTexture,       true)  \
+    X("cross.png",                  okIconTexture,           true)  \
+    X("circle.png",                 circleIconTexture,       true)  \
+    X("triangle.png",               triangleIconTexture,     true)  \
+    X("square.png",                 squareIconTexture,       true)  \
+    X("select.png",                 selectIconTexture,       true)  \
+    X("start.png",                  startIconTexture,        true)  \
+    X("memcard_40h.png",            rootMemIcon,             true)  \
+    X("internal_40h.png",           rootInternalIcon,        true)  \
+    X("usb_21h.png",                rootUsbIcon,             true)  \
+    X("categories_25h.png",         rootCategoriesIcon,      true)  \
+    X("ark4_small_border_18h.png",  rootArk4Icon,            true)  \
+    X("pro_me_18h.png",             rootProMeIcon,           true)  \
+    X("off_bulb_18h.png",           rootOffBulbIcon,         true)  \
+    X("memcard_small.png",          memcardSmallIcon,        false) \
+    X("internal_small.png",         internalSmallIcon,       false) \
+    X("icon0.png",                  placeholderIconTexture,  false) \
+    X("ps1.png",                    ps1IconTexture,          false) \
+    X("homebrew.png",               homebrewIconTexture,     false) \
+    X("iso.png",                    isoIconTexture,          false) \
+    X("update.png",                 updateIconTexture,       false) \
+    X("folder.png",                 catFolderIcon,           false) \
+    X("categoriessettings_15h.png", catSettingsIcon,         false) \
+    X("L.png",                      lIconTexture,            false) \
+    X("R.png",                      rIconTexture,            false) \
+    X("unchecked.png",              checkTexUnchecked,       false) \
+    X("checked.png",                checkTexChecked,         false) \
+    X("warning.png",                warningIconTexture,      false) \
+    X("updown.png",                 updownIconTexture,       false) \
+    X("blacklist.png",              blacklistIcon,           false) \
+    X("folder_grayscale.png",       catFolderIconGray,       false) \
+    X("ps1_grayscale.png",          ps1IconTextureGray,      false) \
+    X("homebrew_grayscale.png",     homebrewIconTextureGray, false) \
+    X("iso_grayscale.png",          isoIconTextureGray,      false) \
+    X("update_grayscale.png",       updateIconTextureGray,   false)
+
+static const uint32_t    KFE_UI_PACK_MAGIC   = 0x4B504648;  // "HFPK"
+static const uint32_t    KFE_UI_PACK_VERSION = 2;
+static const int         KFE_UI_PACK_ATLAS_W = 512;         // GE max texture width
+static const char* const KFE_UI_PACK_FILE    = "ui_pack.bin";
+
+struct KfeUiPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;          // entries in KFE_UI_TEXTURES
+    uint32_t atlasW;
+    uint32_t atlasH;
+    uint32_t dataOffset;     // 64-byte aligned start of the atlas pixels
+    uint32_t reserved[2];
+};
+struct KfeUiPackRect {
+    uint16_t x, y, w, h;     // w == 0: PNG was missing when the pack was built
+    uint32_t srcSize;        // byte size of that PNG
+};
+
+#endif // KFE_UI_PACK_H
@@ -31,12 +31,25 @@ Texture* texLoadPNG(const char* path) {
     t->height = h;
     t->stride = tw;
     t->data   = p2buf;
+    t->ownsData = true;
+    return t;
+}
+
+Texture* texFromAtlas(uint32_t* atlas, int atlasW, int x, int y, int w, int h) {
+    if (!atlas || w <= 0 || h <= 0 || (x & 3)) return nullptr;
+    Texture* t = (Texture*)malloc(sizeof(Texture));
+    if (!t) return nullptr;
+    t->width  = w;
+    t->height = h;
+    t->stride = atlasW;
+    t->data   = atlas + (size_t)y * atlasW + x;
+    t->ownsData = false;
     return t;
 }
 
 void texFree(Texture* t) {
     if (!t) return;
-    if (t->data) free(t->data);
+    if (t->data && t->ownsData) free(t->data);
     free(t);
 }
 
@@ -61,5 +74,6 @@ Texture* texLoadPNGFromMemory(const unsigned char* data, int len) {
     t->height = h;
     t->stride = tw;
     t->data   = p2buf;
+    t->ownsData = true;
     return t;
 }
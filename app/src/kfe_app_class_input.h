@@ -752,6 +752,10 @@
                 if (dev == "__USB_MODE__") {
                     if (!gUsbActive) {
                         // Start drivers and activate mass storage when entering USB Mode.
+                        DevPrefetchReset(true);   // worker must be off the filesystem first
+                        kfeTrashPauseNow();       // likewise the trash purger
+                        gclFlushFilters();        // the PC must see the current filter files
+                        captureUsbFingerprints(); // lets us rescan only what the PC touched
                         UsbStartStacked();
                         UsbActivate();
                         gUsbActive = true;
@@ -896,8 +900,27 @@
 
     void run(){
         init();
+        kfeBootMark("gu + fonts");
         while (1) {
-            renderOneFrame();
+            if (gKfeExitRequested) { gclFlushFilters(); sceKernelExitGame(); }
+            if (frameNeedsPaint()) renderOneFrame();
+
+            // Startup profile: time-to-first-frame, then the deferred boot work.
+            if (!gKfeBoot.firstFrameUs) {
+                gKfeBoot.firstFrameUs = nowUS();
+                kfeBootMark("first frame");
+                kfeBootDeferredInit();
+            }
+            if (!gKfeBoot.texLogged && gKfeTexLoader.done) {
+                gKfeBoot.texLogged = true;
+                logf("bootprof: %d deferred textures done +%llu ms", gKfeBoot.texLoaded,
+                     (gKfeBoot.texDoneUs - gKfeBoot.t0) / 1000ULL);
+                if (gKfeBoot.packLoaded)
+                    logf("bootprof: ui pack used, %d from atlas, %d loose overrides",
+                         gKfeResPack.packed, gKfeResPack.overridden);
+                else
+                    logf("bootprof: ui pack unavailable");
+            }
 
             // One-shot deferred boot migration:
             // show main screen first, then run legacy gclite_filter conversion behind a blocking modal.
@@ -943,6 +966,7 @@
                     gclHardCheckDone = true;
                     gclComputeInitial();
                     gclHardCheckPrxIfEnabled();
+                    kfeBootMark("plugin checks");
                 }
             }
 
@@ -955,6 +979,7 @@
 
             // Handle active dialogs
             if (msgBox) {
+                pollConfirmVerifyToggle();
                 if (!msgBox->update()) {
                     const bool canceled = msgBox->wasCanceled();
                     delete msgBox; msgBox = nullptr; inputWaitRelease = true;
@@ -1301,6 +1326,8 @@
                                     const bool sortTurnedOff =
                                         (pending == GCL_SK_Sort && prevCatsort != 0 && gclCfg.catsort == 0);
                                     const bool forceStripNumbers = sortTurnedOff;
+                                    KfeCatTopoScope catTopo;   // enforce + refresh share one listing per root
+                                    GclFilterBatch filterBatch;
                                     // Clear run-once guard so future opens are allowed to re-enforce if needed
                                     gclSchemeApplied.erase(rootPrefix(currentDevice));
                                     s_catNamingEnforced.erase(rootPrefix(currentDevice));
@@ -1538,7 +1565,7 @@
                             } else {
                                 std::string cat = entries[selectedIndex].d_name;
 
-                                int games = countGamesInCategory(currentDevice, cat);
+                                int games = categoryGameCount(currentDevice, cat);
                                 char subtitle[128];
                                 if (games > 0) {
                                     snprintf(subtitle, sizeof(subtitle),
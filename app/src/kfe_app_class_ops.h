@@ -65,15 +65,16 @@
             (int)opSrcPaths.size(), opDestDevice.c_str(),
             (opDestCategory.empty() ? "Uncategorized" : opDestCategory.c_str()));
 
-        // PSP Go ms0 mode cached free-space preflight (same as Move)
+        // PSP Go ms0 mode free-space preflight (same as Move)
         if (dualDeviceAvailableFromMs0()) {
             const std::string destDevFull = opDestDevice.empty() ? currentDevice : opDestDevice;
-            const uint64_t need = bytesNeededForOp(opSrcPaths, opSrcKinds, destDevFull, actionMode==AM_Copy);
+            uint64_t freeBytes = 0;
+            const bool haveFree = FreeSpaceQuery(destDevFull.c_str(), freeBytes);
+            static const uint64_t HEADROOM = (1ull << 20);  // FAT/metadata updates; slack is in need
+            const uint64_t need = bytesNeededForOp(opSrcPaths, opSrcKinds, destDevFull, actionMode==AM_Copy,
+                                                   haveFree ? freeBytes + HEADROOM : ~0ull);
             if (need > 0) {
-                uint64_t freeBytes = 0; bool haveFree=false;
-                FreeSpaceGet(destDevFull.c_str(), freeBytes, haveFree);
                 if (haveFree) {
-                    static const uint64_t HEADROOM = (4ull << 20);
                     if (freeBytes + HEADROOM < need) {
                         MessageBox mb("Not enough free space on destination.\n\nCopy requires more space than available.",
                                     nullptr, SCREEN_WIDTH, SCREEN_HEIGHT, 0.9f, 0, "OK", 16, 18, 8, 14);
@@ -88,6 +89,9 @@
         renderOneFrame();
 
         KfeFileOps::resetCriticalGuardFailure();
+        KfeDirCacheScope dirCache;   // listings stay valid for the whole batch
+        KfeIoBufferScope ioBuf;      // one copy buffer for every file in the batch
+        DevPrefetchReset(false);
         int okCount = 0, failCount = 0;
         bool canceledCritical = false;
         std::vector<std::pair<std::string, std::string>> copiedPairs;
@@ -123,8 +127,11 @@
         }
 
 
+        dirCache.end();
+        ioBuf.end();
         delete msgBox; msgBox = nullptr;
         logf("=== performCopy: done ok=%d fail=%d ===", okCount, failCount);
+        frameDirty = true;
         logClose();
 
         // ---- Refresh rules for COPY (compute BEFORE restoring op state) ----
@@ -391,11 +398,13 @@
         char subtitle[96];
         snprintf(subtitle, sizeof(subtitle),
                  "%s %d %s?", verb, count, (count == 1) ? "app" : "apps");
-        msgBoxOwnedText = std::string(title) + "\n" + subtitle;
+        opVerify = false;
+        opVerifyKeyHeld = true;   // □ must be released before it toggles
+        msgBoxOwnedText = std::string(title) + "\n" + subtitle + "\n" + confirmVerifyLine();
         msgBox = new MessageBox(msgBoxOwnedText.c_str(), okIconTexture, SCREEN_WIDTH, SCREEN_HEIGHT,
                                 0.9f, 15, "Confirm",
                                 10, 18, 82, 9,
-                                240, 75);
+                                240, 92);
         msgBox->setOkAlignLeft(true);
         msgBox->setOkPosition(10, 7);
         msgBox->setOkStyle(0.7f, 0xFFBBBBBB);
@@ -403,9 +412,30 @@
         msgBox->setSubtitleStyle(0.7f, 0xFFBBBBBB);
         msgBox->setSubtitleGapAdjust(-6);
         msgBox->setCancel(circleIconTexture, "Cancel", PSP_CTRL_CIRCLE);
+        msgBox->setInlineIcon(squareIconTexture, "square.png");
         opPhase = OP_Confirm;
     }
 
+    static const char* confirmVerifyLine(bool on = false) {
+        return on ? "square.png Verify copies: On" : "square.png Verify copies: Off";
+    }
+
+    // □ while the Move/Copy confirm box is up flips opVerify and redraws the line.
+    void pollConfirmVerifyToggle() {
+        if (!msgBox || opPhase != OP_Confirm || actionMode == AM_None) return;
+        SceCtrlData pad{}; sceCtrlPeekBufferPositive(&pad, 1);
+        const bool down = (pad.Buttons & PSP_CTRL_SQUARE) != 0;
+        if (down && !opVerifyKeyHeld) {
+            opVerify = !opVerify;
+            const size_t nl = msgBoxOwnedText.rfind('\n');
+            if (nl != std::string::npos) {
+                msgBoxOwnedText.replace(nl + 1, std::string::npos, confirmVerifyLine(opVerify));
+                msgBox->setMessage(msgBoxOwnedText.c_str());
+            }
+        }
+        opVerifyKeyHeld = down;
+    }
+
     void performMove() {
         ClockGuard cg; cg.boost333();
         logInit();
@@ -418,8 +448,8 @@
         (void)didCross; // suppress 'set but not used' warnings when no cross-device move happens
 
 
-        // Cached, non-blocking preflight (PSP Go, running from ms0, both devices present).
-        // Uses the background probe only; never calls getFreeBytesCMF() here.
+        // Preflight (PSP Go, running from ms0, both devices present). Uses the
+        // cached value; probes only if nothing is known (e.g. right after USB mode).
         {
             bool hasMs = false, hasEf = false;
             for (auto &r : roots) { if (r=="ms0:/") hasMs = true; if (r=="ef0:/") hasEf = true; }
@@ -427,14 +457,13 @@
             const std::string destDevFull = opDestDevice.empty() ? currentDevice : opDestDevice;
 
             if (!runningFromEf0 && hasMs && hasEf) {
-                const uint64_t need = bytesNeededForOp(opSrcPaths, opSrcKinds, destDevFull, actionMode==AM_Copy);
+                uint64_t freeBytes = 0;
+                const bool haveFree = FreeSpaceQuery(destDevFull.c_str(), freeBytes);
+                static const uint64_t HEADROOM = (1ull << 20); // ~1 MiB; cluster slack is in need
+                const uint64_t need = bytesNeededForOp(opSrcPaths, opSrcKinds, destDevFull, actionMode==AM_Copy,
+                                                       haveFree ? freeBytes + HEADROOM : ~0ull);
                 if (need > 0) { // only matters for cross-device moves
-                    uint64_t freeBytes = 0;
-                    bool haveFree = false;
-                    FreeSpaceGet(destDevFull.c_str(), freeBytes, haveFree /*ok*/);
-
                     if (haveFree) {
-                        static const uint64_t HEADROOM = (4ull << 20); // ~4 MiB
                         logf("preflight(cached): need=%llu free=%llu on %s",
                             (unsigned long long)need, (unsigned long long)freeBytes, canonicalDev(destDevFull.c_str()));
                         if (freeBytes + HEADROOM < need) {
@@ -446,7 +475,7 @@
                             return; // abort move
                         }
                     } else {
-                        // No cached number yet — proceed (picker already handled disabling when cache arrived).
+                        // Probe failed — proceed; the copy itself reports a full device.
                         logf("preflight(cached): free unknown on %s; proceeding", canonicalDev(destDevFull.c_str()));
                     }
                 }
@@ -459,6 +488,9 @@
         renderOneFrame();
 
         KfeFileOps::resetCriticalGuardFailure();
+        KfeDirCacheScope dirCache;   // listings stay valid for the whole batch
+        KfeIoBufferScope ioBuf;      // one copy buffer for every file in the batch
+        DevPrefetchReset(false);
         int okCount = 0, failCount = 0;
         bool canceledCritical = false;
         struct MovedPair {
@@ -514,15 +546,21 @@
         }
 
 
+        dirCache.end();
+        ioBuf.end();
         delete msgBox; msgBox = nullptr;
         logf("=== performMove: done ok=%d fail=%d ===", okCount, failCount);
+        frameDirty = true;
         logClose();
 
         // didCross already computed inside the loop
 
         // Update gclite_filter for moved items only (never for copies)
-        for (const auto& mv : movedPairs) {
-            updateGameFilterOnItemRename(mv.src, mv.dst);
+        {
+            GclFilterBatch filterBatch;   // one filter write for the whole move
+            for (const auto& mv : movedPairs) {
+                updateGameFilterOnItemRename(mv.src, mv.dst);
+            }
         }
         const bool forceFullRescanAfterMove = movedCurrentApp;
         if (movedCurrentApp && !movedCurrentAppDst.empty()) {
@@ -633,7 +671,10 @@
     // -----------------------------------------------------------
 public:
     KernelFileExplorer(){ detectRoots(); scrubHiddenAppFiltersOnStartup(); buildRootRows(); }
+    // Deferred gclite filter edits pending (see GclFilterBatch); used by the exit callback.
+    static bool filterBatchOpen() { return gclFilterBatchDepth > 0; }
     ~KernelFileExplorer(){
+        kfeTexLoaderWait();   // the loader may still be filling texture slots freed below
         setMsLedSuppressed(false);
         if (font) intraFontUnload(font);
         if (fontJpn) intraFontUnload(fontJpn);
@@ -669,6 +710,8 @@ public:
         if (updateIconTextureGray) { texFree(updateIconTextureGray); updateIconTextureGray = nullptr; }
         if (warningIconTexture) { texFree(warningIconTexture); warningIconTexture = nullptr; }
         if (updownIconTexture) { texFree(updownIconTexture); updownIconTexture = nullptr; }
+        // Atlas sub-rect textures above don't own their pixels; the pack does.
+        if (gKfeResPack.blob) { free(gKfeResPack.blob); gKfeResPack.blob = nullptr; }
         if (!gPopAnimFrames.empty()) { freeAnimationFrames(gPopAnimFrames); gPopAnimMinDelayUs = 0; }
         if (!gHomeAnimFrames.empty()) { freeAnimationFrames(gHomeAnimFrames); gHomeAnimMinDelayUs = 0; }
         freeHomeAnimStreaming();  // Free streaming mode resources
@@ -280,6 +280,7 @@
                         }
                         maybeUpdateExecBase(r);
                     };
+                    GclFilterBatch filterBatch;
                     for (auto r : isoRoots)  maybeUpdate(r);
                     for (auto r : gameRoots) maybeUpdate(r);
                 }
@@ -514,6 +515,25 @@
     }
 
     void renderOneFrame() {
+        frameAnimating = false;
+        frameWakeUS = 0;
+        waitProgressSwapLatched();
+        drawFrame();
+
+        sceGuSync(0,0);
+        sceDisplayWaitVblankStart();
+        sceGuSwapBuffers();
+
+        SceCtrlData pad{}; sceCtrlPeekBufferPositive(&pad, 1);
+        frameDirty = false;
+        framePaintUS = nowUS();
+        framePaintGen = gKfeUiGen;
+        framePaintSig = frameStateSig();
+        framePaintPad = pad.Buttons;
+    }
+
+    // Build and kick the display list for the whole screen (no sync/swap).
+    void drawFrame() {
         sceGuStart(GU_DIRECT, list);
         sceGuDisable(GU_DEPTH_TEST);
         sceGuDepthMask(GU_TRUE);
@@ -568,24 +588,69 @@
                 UsbStopStacked();
                 gUsbActive = false;
                 gUsbShownConnected = false;
+                kfeTrashResume();
                 delete gUsbBox; gUsbBox = nullptr;
                 inputWaitRelease = true;
                 reloadHomeAnimationsForExec();
                 gclRunPostUsbIntegrityHeal();
+                FreeSpaceForget();   // the host may have written anything
+                applyUsbFingerprints();
             }
         }
 
+        sceGuFinish();
+    }
+
+    // Cheap fingerprint of the state the main screen is drawn from; catches
+    // changes made outside input handling (deferred boot work, op results).
+    unsigned frameStateSig() const {
+        unsigned h = 2166136261u;
+        auto mix = [&h](unsigned v) { h = (h ^ v) * 16777619u; };
+        mix((unsigned)selectedIndex); mix((unsigned)scrollOffset);
+        mix((unsigned)view); mix(showRoots); mix((unsigned)opPhase); mix((unsigned)actionMode);
+        mix((unsigned)entries.size()); mix((unsigned)workingList.size()); mix((unsigned)checked.size());
+        return h;
+    }
 
+    // Main loop: repaint only for input, modals, animation, worker results or
+    // state changes. Idle frames just block on the pad read in handleInput.
+    bool frameNeedsPaint() {
+        if (frameDirty || frameAnimating) return true;
+        if (msgBox || fileMenu || optMenu || gUsbBox || gUsbActive || inputWaitRelease) return true;
+        SceCtrlData pad{}; sceCtrlPeekBufferPositive(&pad, 1);
+        if (pad.Buttons || pad.Buttons != framePaintPad) return true;
+        if (gKfeUiGen != framePaintGen) return true;
+        if (frameStateSig() != framePaintSig) return true;
+        const unsigned long long now = nowUS();
+        if (frameWakeUS && now >= frameWakeUS) return true;
+        return now - framePaintUS >= KFE_IDLE_PAINT_US;
+    }
 
-        sceGuFinish();
+    // For copy/delete loops: msgBox->updateProgress() just records state, this
+    // paints it at most every KFE_PROGRESS_PAINT_US. force = paint now.
+    // Unlike renderOneFrame it never waits for vblank: the swap is latched at
+    // the next one (sceGuSwapBuffers' default NEXTFRAME mode) while the I/O
+    // loop carries on; only the GE sync for the list itself is waited on.
+    void renderProgressFrame(bool force = false) {
+        if (!force && progressPaintUS && nowUS() - progressPaintUS < KFE_PROGRESS_PAINT_US) return;
+        waitProgressSwapLatched();
+        drawFrame();
         sceGuSync(0,0);
-        sceDisplayWaitVblankStart();
         sceGuSwapBuffers();
+        progressSwapPending = true;
+        progressPaintUS = nowUS();
     }
 
 
 
 
+    // A progress swap latches on the next vblank; until then the draw buffer
+    // is the one on screen. Only a paint within a frame of it has to wait.
+    void waitProgressSwapLatched() {
+        if (progressSwapPending && nowUS() - progressPaintUS < 17 * 1000) sceDisplayWaitVblankStart();
+        progressSwapPending = false;
+    }
+
     void selectByPath(const std::string& path){
         if (path.empty()) return;
         for (int i = 0; i < (int)workingList.size(); ++i) {
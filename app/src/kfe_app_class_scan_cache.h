@@ -46,89 +46,53 @@
         }
     }
 
-    void scanIsoRootDir(const std::string& base){
-        if (!dirExists(base)) return;
-        forEachEntry(base, [&](const SceIoDirent &e){
-            maybeRenderPopulating();
-            std::string name = e.d_name;
-            if (FIO_S_ISDIR(e.d_stat.st_mode)) {
-                if (isBlacklistedCategoryFolder("ISO/", name, base)) return;
-                hasCategories = true;
-
-                // Ensure the category is created/listed even if empty or contains no ISO-like files
-                categories[name];  // creates empty vector if not present
-
-                std::string catDir = base + name;
-                forEachEntry(catDir, [&](const SceIoDirent &ee){
-                    maybeRenderPopulating();
-                    if (!FIO_S_ISDIR(ee.d_stat.st_mode)){
-                        std::string fn = ee.d_name;
-                        if (isIsoLike(fn)){
-                            GameItem gi; gi.kind = GameItem::ISO_FILE;
-                            gi.label = fn;
-                            gi.path  = joinDirFile(catDir, fn.c_str());
-                            SceIoStat st;
-                            if (getStat(gi.path, st)){
-                                gi.time     = st.sce_st_ctime;
-                                gi.sortKey  = buildLegacySortKey(gi.time);
-                                gi.sizeBytes= (uint64_t)st.st_size;
-                            }
-
-                            if (endsWithNoCase(fn, ".iso")) {
-                                std::string t; if (readIsoTitle(gi.path, t)) gi.title = t;
-                            } else if (endsWithNoCase(fn, ".cso") || endsWithNoCase(fn, ".zso")) {
-                                std::string t; if (readCompressedIsoTitle(gi.path, t)) gi.title = t;
-                            } else if (endsWithNoCase(fn, ".dax")) {
-                                std::string t; if (readDaxTitle(gi.path, t)) gi.title = t;
-                            } else if (endsWithNoCase(fn, ".jso")) {
-                                std::string t; if (readJsoTitle(gi.path, t)) gi.title = t;
-                            }
+    // One top-level entry of an ISO root: a category folder or an uncategorized image.
+    void scanIsoRootEntry(const std::string& base, const std::string& name, bool isDir){
+        if (isDir) {
+            if (isBlacklistedCategoryFolder("ISO/", name, base)) return;
+            hasCategories = true;
 
-                            categories[name].push_back(gi);
-                            snapInsertSorted(flatAll, gi);
-                        }
-                    }
-                });
-                std::sort(categories[name].begin(), categories[name].end(),
-                          [](const GameItem& a, const GameItem& b){
-                              return strcasecmp(a.label.c_str(), b.label.c_str()) < 0;
-                          });
-            } else {
-                if (isIsoLike(name)){
-                    GameItem gi; gi.kind = GameItem::ISO_FILE;
-                    gi.label = name;
-                    gi.path  = joinDirFile(base, name.c_str());
-                    SceIoStat st;
-                    if (getStat(gi.path, st)){
-                        gi.time     = st.sce_st_ctime;
-                        gi.sortKey  = buildLegacySortKey(gi.time);
-                        gi.sizeBytes= (uint64_t)st.st_size;
-                    }
+            // Ensure the category is created/listed even if empty or contains no ISO-like files
+            categories[name];  // creates empty vector if not present
 
-                    if (endsWithNoCase(name, ".iso")) {
-                        std::string t; if (readIsoTitle(gi.path, t)) gi.title = t;
-                    } else if (endsWithNoCase(name, ".cso") || endsWithNoCase(name, ".zso")) {
-                        std::string t; if (readCompressedIsoTitle(gi.path, t)) gi.title = t;
-                    } else if (endsWithNoCase(name, ".dax")) {
-                        std::string t; if (readDaxTitle(gi.path, t)) gi.title = t;
-                    } else if (endsWithNoCase(name, ".jso")) {
-                        std::string t; if (readJsoTitle(gi.path, t)) gi.title = t;
+            std::string catDir = base + name;
+            forEachEntry(catDir, [&](const SceIoDirent &ee){
+                maybeRenderPopulating();
+                if (!FIO_S_ISDIR(ee.d_stat.st_mode)){
+                    std::string fn = ee.d_name;
+                    if (isIsoLike(fn)){
+                        GameItem gi;
+                        if (!DevPrefetchTake(joinDirFile(catDir, fn.c_str()), gi)) gi = makeIsoGameItem(catDir, fn);
+                        categories[name].push_back(gi);
+                        snapInsertSorted(flatAll, gi);
                     }
-
-                    uncategorized.push_back(gi);
-                    snapInsertSorted(flatAll, gi);
                 }
+            });
+            std::sort(categories[name].begin(), categories[name].end(),
+                      [](const GameItem& a, const GameItem& b){
+                          return strcasecmp(a.label.c_str(), b.label.c_str()) < 0;
+                      });
+        } else {
+            if (isIsoLike(name)){
+                GameItem gi;
+                if (!DevPrefetchTake(joinDirFile(base, name.c_str()), gi)) gi = makeIsoGameItem(base, name);
+                uncategorized.push_back(gi);
+                snapInsertSorted(flatAll, gi);
             }
-        });
+        }
     }
 
-
-    void scanGameRootDir(const std::string& base){
+    void scanIsoRootDir(const std::string& base){
         if (!dirExists(base)) return;
         forEachEntry(base, [&](const SceIoDirent &e){
             maybeRenderPopulating();
-            if (!FIO_S_ISDIR(e.d_stat.st_mode)) return;
-            std::string name = e.d_name;
+            scanIsoRootEntry(base, e.d_name, FIO_S_ISDIR(e.d_stat.st_mode));
+        });
+    }
+
+
+    // One top-level folder of a GAME root: a stand-alone game or a category folder.
+    void scanGameRootEntry(const std::string& base, std::string name){
             std::string baseName = stripCategoryPrefixes(name);
             bool isBlacklisted = isBlacklistedBaseNameFor(base, baseName);
             if (isBlacklisted && strcasecmp(name.c_str(), baseName.c_str()) != 0) {
@@ -139,22 +103,8 @@
             // If the folder itself contains a PBP (EBOOT/PARAM/PBOOT), treat it as a stand-alone game (UNCATEGORIZED).
             std::string folderNoSlashRoot = joinDirFile(base, name.c_str());
             if (dirExists(folderNoSlashRoot) && !findEbootCaseInsensitive(folderNoSlashRoot).empty()){
-                GameItem gi; gi.kind = GameItem::EBOOT_FOLDER;
-                gi.label = name;
-                gi.path  = folderNoSlashRoot;
-                SceIoStat stF{};
-                if (getStatDirNoSlash(gi.path, stF)) {
-                    gi.time     = stF.sce_st_mtime;
-                    gi.sortKey  = buildLegacySortKey(gi.time);
-                }
-                // Optional: compute folder size
-                uint64_t folderBytes = 0;
-                sumDirBytes(gi.path, folderBytes);
-                gi.sizeBytes = folderBytes;
-                gi.isUpdateDlc = isUpdateDlcFolder(gi.path);
-                fillEbootIconPaths(gi);
-
-                std::string t; if (getFolderTitle(gi.path, t)) gi.title = t;
+                GameItem gi;
+                if (!DevPrefetchTake(folderNoSlashRoot, gi)) gi = makeEbootGameItem(folderNoSlashRoot, name);
                 uncategorized.push_back(gi);
                 snapInsertSorted(flatAll, gi);
                 return;
@@ -173,22 +123,8 @@
                     std::string folderNoSlash = joinDirFile(catDir, title.c_str());
                     if (dirExists(folderNoSlash)){
                         if (!findEbootCaseInsensitive(folderNoSlash).empty()){
-                            GameItem gi; gi.kind = GameItem::EBOOT_FOLDER;
-                            gi.label = title;
-                            gi.path  = folderNoSlash;
-                            SceIoStat stF{};
-                            if (getStatDirNoSlash(gi.path, stF)) {
-                                gi.time     = stF.sce_st_mtime;
-                                gi.sortKey  = buildLegacySortKey(gi.time);
-                            }
-                    // Optional: compute folder size for display (can be O(total files))
-                            uint64_t folderBytes = 0;
-                            sumDirBytes(gi.path, folderBytes);
-                            gi.sizeBytes = folderBytes;
-                            gi.isUpdateDlc = isUpdateDlcFolder(gi.path);
-                            fillEbootIconPaths(gi);
-
-                            std::string t; if (getFolderTitle(gi.path, t)) gi.title = t;
+                            GameItem gi;
+                            if (!DevPrefetchTake(folderNoSlash, gi)) gi = makeEbootGameItem(folderNoSlash, title);
                             categories[name].push_back(gi);
                             snapInsertSorted(flatAll, gi);
                         }
@@ -199,21 +135,57 @@
                       [](const GameItem& a, const GameItem& b){
                           return strcasecmp(a.label.c_str(), b.label.c_str()) < 0;
                       });
+    }
+
+    void scanGameRootDir(const std::string& base){
+        if (!dirExists(base)) return;
+        forEachEntry(base, [&](const SceIoDirent &e){
+            maybeRenderPopulating();
+            if (!FIO_S_ISDIR(e.d_stat.st_mode)) return;
+            scanGameRootEntry(base, e.d_name);
         });
     }
 
+    static const char* const* scanIsoRoots(size_t& n) {
+        static const char* const r[] = {"ISO/"};
+        n = sizeof(r)/sizeof(r[0]); return r;
+    }
+    static const char* const* scanGameRoots(size_t& n) {
+        static const char* const r[] = {"PSP/GAME/","PSP/GAME/PSX/","PSP/GAME/Utility/","PSP/GAME150/"};
+        n = sizeof(r)/sizeof(r[0]); return r;
+    }
+
 
     void scanDevice(const std::string& dev){
+            KfeDirCacheScope dirCache;   // EBOOT/PARAM/ICON0 probes share one listing per folder
+            DevPrefetchClaim(dev);       // reuse whatever the background worker already finished
             resetLists();
             gclLoadBlacklistFor(dev);
+            gKfeEnumStats = KfeEnumStats();
+            const unsigned long long scanT0 = nowUS();
 
-        const char* isoRoots[]  = {"ISO/"};
-            const char* gameRoots[] = {"PSP/GAME/","PSP/GAME/PSX/","PSP/GAME/Utility/","PSP/GAME150/"};
+            size_t nIso = 0, nGame = 0;
+            const char* const* isoRoots  = scanIsoRoots(nIso);
+            const char* const* gameRoots = scanGameRoots(nGame);
 
-            for (size_t i=0;i<sizeof(isoRoots)/sizeof(isoRoots[0]);++i)  scanIsoRootDir(dev + std::string(isoRoots[i]));
-            for (size_t i=0;i<sizeof(gameRoots)/sizeof(gameRoots[0]);++i) scanGameRootDir(dev + std::string(gameRoots[i]));
+            for (size_t i=0;i<nIso;++i)  scanIsoRootDir(dev + std::string(isoRoots[i]));
+            for (size_t i=0;i<nGame;++i) scanGameRootDir(dev + std::string(gameRoots[i]));
+            DevPrefetchRelease(dev);
 
+            if (kfeLoggingEnabled) {
+                const KfeEnumStats st = gKfeEnumStats;
+                logInit();
+                logf("scanDevice %s: %u entries, %u dir reads, enum %llu us (%llu us/entry), total %llu us, batched=%d",
+                     dev.c_str(), st.entries, st.calls, st.us,
+                     st.entries ? st.us / st.entries : 0ull, nowUS() - scanT0,
+                     (kfeDirBatchEnabled && !gKfeDirBatchMissing) ? 1 : 0);
+                logClose();
+            }
+            finishScanLists(dev);
+        }
 
+    // Shared tail of scanDevice()/rescanChangedSince(): category flags, names and ordering.
+    void finishScanLists(const std::string& dev){
             // Show categories view when Game Categories is enabled OR when category folders exist
             if (!categories.empty() || gclArkOn || gclProOn) hasCategories = true;
 
@@ -252,6 +224,226 @@
             // With eager loading we no longer track per-category load flags.
         }
 
+    // -----------------------------------------------------------
+    // Scan-root fingerprints (USB mode)
+    // -----------------------------------------------------------
+    // key = scan root (its loose files) or one folder directly under a scan root
+    // (its listing); value = FNV-1a over names, modes, sizes and mtimes. Taken
+    // before USB mass storage and compared afterwards, so only folders the PC
+    // actually touched are rescanned.
+    // Game roots also get a deep value: the totals of one pspIoWalkTree call.
+    // Only when that moved are the cached game folders inside categories
+    // (CAT_X/Game/, not covered by any listing above) re-sized one by one
+    // against their cached sizeBytes. A change that keeps every total the
+    // same (same-size EBOOT swap) still waits for the next full rescan.
+    typedef std::map<std::string, uint32_t> ScanFingerprint;
+    std::map<std::string, ScanFingerprint> usbFingerprints;   // key: "ms0:/" or "ef0:/"
+    std::map<std::string, ScanFingerprint> usbDeepFingerprints;
+
+    static uint32_t fpMix(uint32_t h, const void* p, size_t n) {
+        const uint8_t* b = (const uint8_t*)p;
+        for (size_t i = 0; i < n; ++i) { h ^= b[i]; h *= 16777619u; }
+        return h;
+    }
+    static uint32_t fpMixEntry(uint32_t h, const SceIoDirent& e) {
+        h = fpMix(h, e.d_name, strlen(e.d_name) + 1);
+        h = fpMix(h, &e.d_stat.st_mode, sizeof(e.d_stat.st_mode));
+        h = fpMix(h, &e.d_stat.st_size, sizeof(e.d_stat.st_size));
+        h = fpMix(h, &e.d_stat.sce_st_mtime, sizeof(e.d_stat.sce_st_mtime));
+        return h;
+    }
+
+    static void fingerprintScanRoots(const std::string& dev, ScanFingerprint& out, ScanFingerprint& deep) {
+        out.clear();
+        deep.clear();
+        size_t nIso = 0, nGame = 0;
+        const char* const* isoRoots  = scanIsoRoots(nIso);
+        const char* const* gameRoots = scanGameRoots(nGame);
+        std::vector<std::string> bases;
+        for (size_t i = 0; i < nIso; ++i)  bases.push_back(dev + isoRoots[i]);
+        for (size_t i = 0; i < nGame; ++i) bases.push_back(dev + gameRoots[i]);
+
+        for (const auto& base : bases) {
+            uint32_t rootHash = 2166136261u;
+            std::vector<std::string> children;
+            forEachEntry(base, [&](const SceIoDirent& e){
+                if (FIO_S_ISDIR(e.d_stat.st_mode)) children.push_back(e.d_name);
+                else rootHash = fpMixEntry(rootHash, e);
+            });
+            out[base] = rootHash;
+            for (const auto& c : children) {
+                const std::string child = joinDirFile(base, c.c_str());
+                uint32_t h = 2166136261u;
+                forEachEntry(child, [&](const SceIoDirent& e){ h = fpMixEntry(h, e); });
+                out[child] = h;
+            }
+        }
+        for (size_t i = 0; i < nGame; ++i) {
+            const std::string base = dev + gameRoots[i];
+            PspIoTreeStats st;
+            if (!kfeWalkTree(base, st, nullptr)) continue;   // no driver export: listings only
+            uint32_t h = 2166136261u;
+            h = fpMix(h, &st.bytes, sizeof(st.bytes));
+            h = fpMix(h, &st.files, sizeof(st.files));
+            h = fpMix(h, &st.dirs, sizeof(st.dirs));
+            deep[base] = h;
+        }
+    }
+
+    // Lazy half of the deep check: for game roots whose walk totals moved,
+    // re-size the cached game folders that sit inside a category and report
+    // the category folders whose games no longer match.
+    void staleCategoryGames(const ScanFingerprint& before, const ScanFingerprint& after,
+                            std::vector<std::string>& out) {
+        for (const auto& kv : before) {
+            auto it = after.find(kv.first);
+            if (it != after.end() && it->second == kv.second) continue;
+            const std::string& base = kv.first;
+            for (const auto& gi : flatAll) {
+                if (gi.kind != GameItem::EBOOT_FOLDER) continue;
+                const std::string cat = parentOf(gi.path);
+                if (parentOf(cat) + "/" != base) continue;
+                if (std::find(out.begin(), out.end(), cat) != out.end()) continue;
+                uint64_t bytes = 0;
+                if (sumDirBytes(gi.path, bytes) && bytes == gi.sizeBytes) continue;   // gone -> stale too
+                out.push_back(cat);
+            }
+        }
+    }
+
+    // Before USB mass storage: remember what every cleanly cached device looked like.
+    void captureUsbFingerprints() {
+        usbFingerprints.clear();
+        usbDeepFingerprints.clear();
+        for (const auto& r : roots) {
+            auto it = deviceCache.find(r);
+            if (it == deviceCache.end() || it->second.dirty) continue;
+            fingerprintScanRoots(r, usbFingerprints[r], usbDeepFingerprints[r]);
+        }
+    }
+
+    template <typename Pred>
+    void dropScanItemsIf(Pred pred) {
+        auto rm = [&](std::vector<GameItem>& v){ v.erase(std::remove_if(v.begin(), v.end(), pred), v.end()); };
+        rm(flatAll); rm(uncategorized);
+        for (auto& kv : categories) rm(kv.second);
+    }
+
+    // Patch the current lists for every fingerprint key that differs from 'before'.
+    // Items under a changed folder are dropped and that folder alone is rescanned.
+    // 'extra' adds folders found stale some other way (staleCategoryGames).
+    void rescanChangedSince(const std::string& dev, const ScanFingerprint& before, const ScanFingerprint& after,
+                            const std::vector<std::string>& extra) {
+        std::vector<std::string> changed;
+        for (const auto& kv : before) {
+            auto it = after.find(kv.first);
+            if (it == after.end() || it->second != kv.second) changed.push_back(kv.first);
+        }
+        for (const auto& kv : after)
+            if (!before.count(kv.first)) changed.push_back(kv.first);
+        for (const auto& k : extra)
+            if (std::find(changed.begin(), changed.end(), k) == changed.end()) changed.push_back(k);
+        if (changed.empty()) return;
+
+        KfeDirCacheScope dirCache;
+        gclLoadBlacklistFor(dev);
+
+        size_t nIso = 0, nGame = 0;
+        const char* const* isoRoots  = scanIsoRoots(nIso);
+        const char* const* gameRoots = scanGameRoots(nGame);
+        auto isIsoBase = [&](const std::string& b){
+            for (size_t i = 0; i < nIso; ++i) if (b == dev + isoRoots[i]) return true;
+            return false;
+        };
+        auto isBase = [&](const std::string& b){
+            if (isIsoBase(b)) return true;
+            for (size_t i = 0; i < nGame; ++i) if (b == dev + gameRoots[i]) return true;
+            return false;
+        };
+
+        // PSP/GAME/PSX and PSP/GAME/Utility are folders under PSP/GAME/ and roots
+        // of their own, so their games are listed both ways; any change in or
+        // below one rescans it both ways.
+        std::vector<std::string> nested;   // e.g. "ms0:/PSP/GAME/PSX"
+        for (const auto& key : changed) {
+            for (size_t i = 0; i < nGame; ++i) {
+                const std::string nb = dev + gameRoots[i];
+                const std::string nk = nb.substr(0, nb.size() - 1);
+                if (!isBase(parentOf(nk) + "/")) continue;   // top-level root
+                if (key != nk && key.compare(0, nb.size(), nb) != 0) continue;
+                if (std::find(nested.begin(), nested.end(), nk) == nested.end()) nested.push_back(nk);
+            }
+        }
+        auto coveredByNested = [&](const std::string& key){
+            for (const auto& n : nested)
+                if (key == n || key.compare(0, n.size() + 1, n + "/") == 0) return true;
+            return false;
+        };
+
+        // Drop everything at or below one folder directly under a root, then rescan it.
+        auto rescanChild = [&](const std::string& key){
+            const std::string base = parentOf(key) + "/";
+            const std::string name = basenameOf(key);
+            const std::string under = key + "/";
+            dropScanItemsIf([&](const GameItem& gi){
+                return gi.path == key || gi.path.compare(0, under.size(), under) == 0;
+            });
+            auto cit = categories.find(name);
+            if (cit != categories.end() && cit->second.empty()) categories.erase(cit);
+            if (!dirExists(key)) return;
+            if (isIsoBase(base)) scanIsoRootEntry(base, name, true);
+            else scanGameRootEntry(base, name);
+            if (isBase(under)) scanGameRootDir(under);
+        };
+
+        categories.erase("Uncategorized");   // re-flagged by finishScanLists()
+        for (const auto& n : nested) {
+            logf("usb-rescan: %s (nested root)", n.c_str());
+            rescanChild(n);
+        }
+        for (const auto& key : changed) {
+            if (coveredByNested(key)) continue;
+            logf("usb-rescan: %s", key.c_str());
+            if (isBase(key)) {
+                // Loose files directly in a root: only ISO roots list those as games.
+                if (!isIsoBase(key)) continue;
+                dropScanItemsIf([&](const GameItem& gi){ return gi.kind == GameItem::ISO_FILE && parentOf(gi.path) + "/" == key; });
+                forEachEntry(key, [&](const SceIoDirent& e){
+                    if (!FIO_S_ISDIR(e.d_stat.st_mode)) scanIsoRootEntry(key, e.d_name, false);
+                });
+                continue;
+            }
+            rescanChild(key);
+        }
+
+        hasCategories = false;
+        categoryNames.clear();
+        finishScanLists(dev);
+    }
+
+    // After USB mass storage: rescan only what the PC changed, per device.
+    // Devices without a pre-USB fingerprint stay dirty (full scan on next open).
+    void applyUsbFingerprints() {
+        if (usbFingerprints.empty()) return;
+        ScanSnapshot saved; snapshotCurrentScan(saved);
+        for (auto& kv : usbFingerprints) {
+            const std::string& dev = kv.first;
+            auto it = deviceCache.find(dev);
+            if (it == deviceCache.end() || !dirExists(dev)) continue;
+            ScanFingerprint now, deepNow;
+            fingerprintScanRoots(dev, now, deepNow);
+            restoreScan(it->second.snap);
+            std::vector<std::string> stale;
+            staleCategoryGames(usbDeepFingerprints[dev], deepNow, stale);
+            rescanChangedSince(dev, kv.second, now, stale);
+            snapshotCurrentScan(it->second.snap);
+            it->second.dirty = false;
+        }
+        usbFingerprints.clear();
+        usbDeepFingerprints.clear();
+        restoreScan(saved);
+    }
+
 
     // Add categories that exist on disk but are missing from the current cache (e.g., after removing blacklist entries).
     void refreshNewlyAllowedCategories(const std::string& dev) {
@@ -284,7 +476,7 @@
             if (existing.find(base) != existing.end() && baseHasItems[base]) return;
 
             std::string subAbs = joinDirFile(absRoot, sub.c_str());
-            if (!findEbootCaseInsensitive(subAbs).empty()) return; // skip real games
+            if (kfeIsGameFolderIn(absRoot, sub)) return; // skip real games
 
             std::vector<GameItem> items;
             forEachEntry(subAbs, [&](const SceIoDirent &ee){
@@ -332,7 +524,7 @@
             if (existing.find(base) != existing.end() && baseHasItems[base]) return;
 
             std::string subAbs = joinDirFile(absRoot, sub.c_str());
-            if (!findEbootCaseInsensitive(subAbs).empty()) return; // sub itself is a game folder
+            if (kfeIsGameFolderIn(absRoot, sub)) return; // sub itself is a game folder
 
             std::vector<GameItem> items;
             forEachEntry(subAbs, [&](const SceIoDirent &e){
@@ -419,7 +611,7 @@
                 if (!isTargetBase(sub)) continue;
                 if (isBlacklistedCategoryFolder(rootLabel, sub, absRoot)) continue;
                 std::string subAbs = joinDirFile(absRoot, sub.c_str());
-                if (!findEbootCaseInsensitive(subAbs).empty()) continue; // skip real games
+                if (kfeIsGameFolderIn(absRoot, sub)) continue; // skip real games
 
                 std::vector<GameItem> items;
                 forEachEntry(subAbs, [&](const SceIoDirent &ee){
@@ -463,7 +655,7 @@
                 if (isBlacklistedCategoryFolder(rootLabel, sub, absRoot)) continue;
 
                 std::string subAbs = joinDirFile(absRoot, sub.c_str());
-                if (!findEbootCaseInsensitive(subAbs).empty()) continue; // sub itself is a game folder
+                if (kfeIsGameFolderIn(absRoot, sub)) continue; // sub itself is a game folder
 
                 std::vector<GameItem> items;
                 forEachEntry(subAbs, [&](const SceIoDirent &e){
@@ -522,6 +714,8 @@
         entries.clear(); entryPaths.clear(); entryKinds.clear();
         rowFlags.clear(); rowFreeBytes.clear(); rowTotalBytes.clear(); rowPresent.clear();
         selectedIndex=0; scrollOffset=0;
+        rowTextCache.clear();
+        frameDirty = true;
         freeSelectionIcon();
     }
 
@@ -657,53 +851,31 @@
         std::string txt;
         if (!gclReadWholeText(gclBlacklistFilePath(), txt)) return;
 
-        auto addUnique = [](std::vector<std::string>& list, const std::string& v) {
-            for (const auto& w : list) {
-                if (!strcasecmp(w.c_str(), v.c_str())) return;
+        auto addUnique = [](KfeNameList& list, const std::string& v) { list.addUniqueFolded(v); };
+
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            KfeTextSpan raw = kfeSpanTrim(line);
+            if (raw.empty()) continue;
+            size_t comma = raw.find(',');
+            bool parsed = false;
+            if (comma != std::string::npos) {
+                KfeTextSpan val = kfeSpanTrim(raw.sub(comma + 1));
+                std::string root;
+                if (gclParseDeviceToken(raw.sub(0, comma), root) && !val.empty()) {
+                    std::string norm = normalizeBlacklistInput(val.str());
+                    if (!norm.empty()) addUnique(gclBlacklistMap[root], norm);
+                    parsed = true;
+                }
             }
-            list.push_back(v);
-        };
-        auto parseDevice = [](std::string tok, std::string& outRoot) -> bool {
-            size_t a = 0, b = tok.size();
-            while (a < b && (tok[a] == ' ' || tok[a] == '\t')) ++a;
-            while (b > a && (tok[b-1] == ' ' || tok[b-1] == '\t')) --b;
-            tok = tok.substr(a, b - a);
-            if (tok.size() >= 4 && tok[3] == ':') tok = tok.substr(0, 3);
-            for (char& c : tok) c = toLowerC(c);
-            if (tok == "ms0") { outRoot = "ms0:/"; return true; }
-            if (tok == "ef0") { outRoot = "ef0:/"; return true; }
-            return false;
-        };
-
-        size_t pos = 0, start = 0;
-        while (pos <= txt.size()) {
-            if (pos == txt.size() || txt[pos] == '\n' || txt[pos] == '\r') {
-                std::string raw = trimSpaces(txt.substr(start, pos - start));
-                if (!raw.empty()) {
-                    size_t comma = raw.find(',');
-                    bool parsed = false;
-                    if (comma != std::string::npos) {
-                        std::string devTok = raw.substr(0, comma);
-                        std::string val = trimSpaces(raw.substr(comma + 1));
-                        std::string root;
-                        if (parseDevice(devTok, root) && !val.empty()) {
-                            val = normalizeBlacklistInput(val);
-                            if (!val.empty()) addUnique(gclBlacklistMap[root], val);
-                            parsed = true;
-                        }
-                    }
-                    if (!parsed) {
-                        std::string val = normalizeBlacklistInput(raw);
-                        if (!val.empty()) {
-                            addUnique(gclBlacklistMap["ms0:/"], val);
-                            addUnique(gclBlacklistMap["ef0:/"], val);
-                        }
-                    }
+            if (!parsed) {
+                std::string val = normalizeBlacklistInput(raw.str());
+                if (!val.empty()) {
+                    addUnique(gclBlacklistMap["ms0:/"], val);
+                    addUnique(gclBlacklistMap["ef0:/"], val);
                 }
-                if (pos < txt.size() && txt[pos] == '\r' && pos + 1 < txt.size() && txt[pos + 1] == '\n') ++pos;
-                start = pos + 1;
             }
-            ++pos;
         }
     }
 
@@ -770,38 +942,42 @@
         return currentExecBaseDir() + "resources/category_lite.prx";
     }
 
-    bool gclFilesEqual(const std::string& a, const std::string& b) {
+    // Size + CRC32 of the bundled PRX. The Makefile bakes both in, so when
+    // the shipped file has the expected size it is never read back.
+    static bool gclBundledPrxDigest(uint32_t& crc, SceOff& size) {
+        const std::string bundled = gclBundledPrxPath();
+#if defined(KFE_BUNDLED_PRX_CRC32) && defined(KFE_BUNDLED_PRX_SIZE)
+        SceIoStat st{};
+        if (!pathExists(bundled, &st)) return false;
+        if (st.st_size == (SceOff)KFE_BUNDLED_PRX_SIZE) {
+            crc = (uint32_t)KFE_BUNDLED_PRX_CRC32;
+            size = st.st_size;
+            return true;
+        }
+#endif
+        return kfeFileCrc32(bundled, crc, &size);
+    }
+
+    static bool gclFileDigest(const std::string& path, uint32_t& crc, SceOff& size) {
+        if (!strcasecmp(path.c_str(), gclBundledPrxPath().c_str())) return gclBundledPrxDigest(crc, size);
+        return kfeFileCrc32(path, crc, &size);
+    }
+
+    // Same size and CRC32; replaces the old two-file byte compare.
+    static bool gclFilesSameDigest(const std::string& a, const std::string& b) {
         SceIoStat sa{}, sb{};
         if (!pathExists(a, &sa) || !pathExists(b, &sb)) return false;
         if (sa.st_size != sb.st_size) return false;
-        if (sa.st_size <= 0) return true;
-
-        SceUID fa = sceIoOpen(a.c_str(), PSP_O_RDONLY, 0);
-        if (fa < 0) return false;
-        SceUID fb = sceIoOpen(b.c_str(), PSP_O_RDONLY, 0);
-        if (fb < 0) { sceIoClose(fa); return false; }
-
-        char ba[16 * 1024];
-        char bb[16 * 1024];
-        bool same = true;
-        while (same) {
-            int ra = sceIoRead(fa, ba, sizeof(ba));
-            int rb = sceIoRead(fb, bb, sizeof(bb));
-            if (ra != rb) { same = false; break; }
-            if (ra < 0) { same = false; break; }
-            if (ra == 0) break;
-            if (memcmp(ba, bb, (size_t)ra) != 0) { same = false; break; }
-        }
-
-        sceIoClose(fa);
-        sceIoClose(fb);
-        return same;
+        uint32_t ca = 0, cb = 0;
+        SceOff za = 0, zb = 0;
+        if (!gclFileDigest(a, ca, za) || !gclFileDigest(b, cb, zb)) return false;
+        return za == zb && ca == cb;
     }
 
     bool gclIsBundledPrxCopy(const std::string& prxPath) {
         std::string bundled = gclBundledPrxPath();
         if (!pathExists(prxPath) || !pathExists(bundled)) return false;
-        return gclFilesEqual(prxPath, bundled);
+        return gclFilesSameDigest(prxPath, bundled);
     }
 
     std::string gclFindLegacyCategoryLitePrx(const std::string& sepluginsNoSlash) {
@@ -877,6 +1053,7 @@
     }
 
     static bool gclReadWholeText(const std::string& path, std::string& out){
+        gclRecoverInterruptedWrite(path);
         SceUID fd = sceIoOpen(path.c_str(), PSP_O_RDONLY, 0);
         if (fd < 0) return false;
         SceIoStat st{}; if (sceIoGetstat(path.c_str(), &st) < 0) { sceIoClose(fd); return false; }
@@ -894,179 +1071,150 @@
         return !out.empty();
     }
 
+    // A crash between the two renames in gclWriteWholeText leaves only the
+    // .bak_hsrt copy; put it back so readers never see a missing file.
+    static void gclRecoverInterruptedWrite(const std::string& path) {
+        const std::string bak = path + ".bak_hsrt";
+        if (!pathExists(bak)) return;
+        if (pathExists(path)) sceIoRemove(bak.c_str());
+        else sceIoRename(bak.c_str(), path.c_str());
+    }
+
+    // Writes to a temp file first and swaps it in, so an interrupted write
+    // can't leave a truncated config behind.
     static bool gclWriteWholeText(const std::string& path, const std::string& data){
-        SceUID fd = sceIoOpen(path.c_str(), PSP_O_WRONLY|PSP_O_CREAT|PSP_O_TRUNC, 0777);
+        const std::string tmp = path + ".tmp_hsrt";
+        const std::string bak = path + ".bak_hsrt";
+        gclRecoverInterruptedWrite(path);
+        sceIoRemove(tmp.c_str());
+
+        SceUID fd = sceIoOpen(tmp.c_str(), PSP_O_WRONLY|PSP_O_CREAT|PSP_O_TRUNC, 0777);
         if (fd < 0) return false;
-        int wr = sceIoWrite(fd, data.data(), (uint32_t)data.size());
+        int wr = data.empty() ? 0 : sceIoWrite(fd, data.data(), (uint32_t)data.size());
         sceIoClose(fd);
-        return wr == (int)data.size();
+        if (wr != (int)data.size()) { sceIoRemove(tmp.c_str()); return false; }
+
+        const bool hadDst = pathExists(path);
+        if (hadDst && sceIoRename(path.c_str(), bak.c_str()) < 0) {
+            sceIoRemove(tmp.c_str());
+            return false;
+        }
+        if (sceIoRename(tmp.c_str(), path.c_str()) < 0) {
+            sceIoRemove(tmp.c_str());
+            if (hadDst) sceIoRename(bak.c_str(), path.c_str());
+            return false;
+        }
+        if (hadDst) sceIoRemove(bak.c_str());
+        return true;
     }
 
     // Accepts: "1" (both files), and for ARK PLUGINS.txt only: "on", "true", "enabled"
     // Accepts:
     //  - PRO/ME VSH.txt: "<path> 1"
     //  - ARK-4 PLUGINS.txt: "vsh, <path>, 1" (also accepts on/true/enabled)
-    bool gclLineEnables(const std::string& line, bool arkPluginsTxt){
-        auto toLower = [](std::string s){ for(char& c:s) if(c>='A'&&c<='Z') c=c-'A'+'a'; return s; };
-        auto trim = [](std::string s){
-            size_t a=0,b=s.size();
-            while (a<b && (s[a]==' '||s[a]=='\t')) ++a;
-            while (b>a && (s[b-1]==' '||s[b-1]=='\t'||s[b-1]=='\r')) --b;
-            return s.substr(a,b-a);
+    bool gclLineEnables(KfeTextSpan line, bool arkPluginsTxt){
+        auto isOnState = [](KfeTextSpan v){
+            return kfeSpanEqNoCase(v, "1") || kfeSpanEqNoCase(v, "on") ||
+                   kfeSpanEqNoCase(v, "true") || kfeSpanEqNoCase(v, "enabled");
         };
 
         if (!arkPluginsTxt) {
             // PRO/ME (incl. LME): space-separated, but tolerate CSV-style lines too.
-            std::string l = toLower(line);
-            std::string trimmed = trim(l);
+            KfeTextSpan trimmed = kfeSpanTrim(line);
             if (trimmed.empty() || trimmed[0] == ';' || trimmed[0] == '#') return false;
-            if (l.find("category_lite.prx") == std::string::npos) return false;
+            if (!kfeSpanContainsNoCase(line, "category_lite.prx")) return false;
 
-            if (l.find(',') != std::string::npos) {
+            if (line.find(',') != std::string::npos) {
                 // Treat as CSV: "vsh, <path>, 1"
-                std::vector<std::string> cols;
-                size_t start=0;
-                while (start<=l.size()){
-                    size_t pos = l.find(',', start);
-                    if (pos == std::string::npos) pos = l.size();
-                    cols.push_back(trim(l.substr(start, pos - start)));
-                    start = pos + (pos < l.size() ? 1 : 0);
-                    if (pos == l.size()) break;
-                }
-                if (cols.size() >= 3 && cols[1].find("category_lite.prx") != std::string::npos) {
-                    const std::string& state = cols[2];
-                    if (state == "0") return false;
-                    if (state == "1" || state == "on" || state == "true" || state == "enabled") return true;
-                    return true; // missing/unknown flag -> treat as enabled
+                KfeFieldCursor cols(line, ',');
+                KfeTextSpan col, path;
+                int idx = 0;
+                while (cols.next(col)) {
+                    if (idx == 1) path = col;
+                    if (idx == 2) {
+                        if (!kfeSpanContainsNoCase(path, "category_lite.prx")) return false;
+                        return !kfeSpanEqNoCase(col, "0"); // missing/unknown flag -> treat as enabled
+                    }
+                    ++idx;
                 }
                 return false;
             }
 
-            std::vector<std::string> toks;
-            size_t i=0; while (i<l.size()){
-                while (i<l.size() && (l[i]==' '||l[i]=='\t'||l[i]=='\r'||l[i]=='\n')) ++i;
-                size_t j=i; while (j<l.size() && !(l[j]==' '||l[j]=='\t'||l[j]=='\r'||l[j]=='\n')) ++j;
-                if (j>i) toks.emplace_back(l.substr(i,j-i));
-                i=j;
-            }
-            for (size_t k=0;k<toks.size();++k){
-                if (toks[k].find("category_lite.prx") != std::string::npos){
-                    bool sawZero = false;
-                    for (size_t m=k+1; m<toks.size(); ++m){
-                        const std::string& v = toks[m];
-                        if (v == "1" || v == "on" || v == "true" || v == "enabled") return true;
-                        if (v == "0") sawZero = true;
-                    }
-                    return !sawZero; // treat missing flag as enabled
+            KfeFieldCursor toks(line, 0);
+            KfeTextSpan tok;
+            while (toks.next(tok)) {
+                if (!kfeSpanContainsNoCase(tok, "category_lite.prx")) continue;
+                bool sawZero = false;
+                while (toks.next(tok)) {
+                    if (isOnState(tok)) return true;
+                    if (kfeSpanEqNoCase(tok, "0")) sawZero = true;
                 }
+                return !sawZero; // treat missing flag as enabled
             }
             return false;
         } else {
             // ARK-4: CSV columns -> "vsh, <path>, 1"
-            std::string l = toLower(line);
-            std::vector<std::string> cols;
-            size_t start=0;
-            while (start<=l.size()){
-                size_t pos = l.find(',', start);
-                if (pos == std::string::npos) pos = l.size();
-                cols.push_back(trim(l.substr(start, pos - start)));
-                start = pos + (pos < l.size() ? 1 : 0);
-                if (pos == l.size()) break;
+            KfeFieldCursor cols(line, ',');
+            KfeTextSpan col, path;
+            int idx = 0;
+            while (cols.next(col)) {
+                if (idx == 1) path = col;
+                if (idx == 2) {
+                    if (!kfeSpanContainsNoCase(path, "category_lite.prx")) return false;
+                    return isOnState(col);
+                }
+                ++idx;
             }
-            if (cols.size() < 3) return false;
-            if (cols[1].find("category_lite.prx") == std::string::npos) return false;
-            const std::string& state = cols[2];
-            return (state == "1" || state == "on" || state == "true" || state == "enabled");
+            return false;
         }
     }
 
-    bool gclExtractCategoryLitePathFromLine(const std::string& line,
+    bool gclExtractCategoryLitePathFromLine(KfeTextSpan line,
                                             bool arkPluginsTxt,
                                             std::string& outPath,
                                             bool& outEnabled) {
         outPath.clear();
         outEnabled = false;
 
-        auto toLower = [](std::string s){ for(char& c:s) if(c>='A'&&c<='Z') c=c-'A'+'a'; return s; };
-        auto trim = [](std::string s){
-            size_t a=0,b=s.size();
-            while (a<b && (s[a]==' '||s[a]=='\t')) ++a;
-            while (b>a && (s[b-1]==' '||s[b-1]=='\t'||s[b-1]=='\r')) --b;
-            return s.substr(a,b-a);
-        };
-
-        auto parseState = [&](const std::string& rawState)->bool {
-            std::string state = toLower(trim(rawState));
-            if (state.empty()) return true; // missing flag -> treat as enabled
-            if (state == "0") return false;
-            if (state == "1" || state == "on" || state == "true" || state == "enabled") return true;
-            return true;
-        };
-
-        if (arkPluginsTxt) {
-            std::vector<std::string> colsRaw;
-            size_t start=0;
-            while (start<=line.size()){
-                size_t pos = line.find(',', start);
-                if (pos == std::string::npos) pos = line.size();
-                colsRaw.push_back(trim(line.substr(start, pos - start)));
-                start = pos + (pos < line.size() ? 1 : 0);
-                if (pos == line.size()) break;
-            }
-            if (colsRaw.size() < 2) return false;
-            std::string pathLow = toLower(colsRaw[1]);
-            if (pathLow.find("category_lite.prx") == std::string::npos) return false;
-            outPath = colsRaw[1];
-            outEnabled = (colsRaw.size() >= 3) ? parseState(colsRaw[2]) : true;
-            return true;
-        }
-
-        // PRO/ME: tolerate both CSV and space-separated
-        if (line.find(',') != std::string::npos) {
-            std::vector<std::string> colsRaw;
-            size_t start=0;
-            while (start<=line.size()){
-                size_t pos = line.find(',', start);
-                if (pos == std::string::npos) pos = line.size();
-                colsRaw.push_back(trim(line.substr(start, pos - start)));
-                start = pos + (pos < line.size() ? 1 : 0);
-                if (pos == line.size()) break;
+        // missing/unknown flag -> treat as enabled
+        auto parseState = [](KfeTextSpan state)->bool { return !kfeSpanEqNoCase(kfeSpanTrim(state), "0"); };
+
+        // ARK-4 always, PRO/ME when the line looks like CSV: "vsh, <path>[, state]"
+        if (arkPluginsTxt || line.find(',') != std::string::npos) {
+            KfeFieldCursor cols(line, ',');
+            KfeTextSpan col, path;
+            int idx = 0;
+            bool havePath = false, haveState = false;
+            while (cols.next(col)) {
+                if (idx == 1) { path = col; havePath = true; }
+                if (idx == 2) { outEnabled = parseState(col); haveState = true; break; }
+                ++idx;
             }
-            if (colsRaw.size() >= 2) {
-                std::string pathLow = toLower(colsRaw[1]);
-                if (pathLow.find("category_lite.prx") != std::string::npos) {
-                    outPath = colsRaw[1];
-                    outEnabled = (colsRaw.size() >= 3) ? parseState(colsRaw[2]) : true;
-                    return true;
-                }
+            if (havePath && kfeSpanContainsNoCase(path, "category_lite.prx")) {
+                outPath = path.str();
+                if (!haveState) outEnabled = true;
+                return true;
             }
-        }
-
-        std::vector<std::string> toks;
-        size_t i=0;
-        while (i<line.size()){
-            while (i<line.size() && (line[i]==' '||line[i]=='\t'||line[i]=='\r'||line[i]=='\n')) ++i;
-            size_t j=i; while (j<line.size() && !(line[j]==' '||line[j]=='\t'||line[j]=='\r'||line[j]=='\n')) ++j;
-            if (j>i) toks.emplace_back(line.substr(i,j-i));
-            i=j;
-        }
-        for (size_t k=0; k<toks.size(); ++k){
-            std::string lowTok = toLower(toks[k]);
-            if (lowTok.find("category_lite.prx") != std::string::npos) {
-                outPath = toks[k];
-                // Find first explicit state token after path
-                bool sawState = false;
-                for (size_t m=k+1; m<toks.size(); ++m){
-                    std::string lowState = toLower(trim(toks[m]));
-                    if (lowState=="0" || lowState=="1" || lowState=="on" || lowState=="true" || lowState=="enabled"){
-                        outEnabled = parseState(lowState);
-                        sawState = true;
-                        break;
-                    }
+            outEnabled = false;
+            if (arkPluginsTxt) return false;
+        }
+
+        // PRO/ME: space-separated
+        KfeFieldCursor toks(line, 0);
+        KfeTextSpan tok;
+        while (toks.next(tok)) {
+            if (!kfeSpanContainsNoCase(tok, "category_lite.prx")) continue;
+            outPath = tok.str();
+            // Find first explicit state token after path
+            outEnabled = true;
+            while (toks.next(tok)) {
+                if (kfeSpanEqNoCase(tok, "0") || kfeSpanEqNoCase(tok, "1") || kfeSpanEqNoCase(tok, "on") ||
+                    kfeSpanEqNoCase(tok, "true") || kfeSpanEqNoCase(tok, "enabled")) {
+                    outEnabled = parseState(tok);
+                    break;
                 }
-                if (!sawState) outEnabled = true;
-                return true;
             }
+            return true;
         }
         return false;
     }
@@ -1075,19 +1223,14 @@
         if (filePath.empty()) return {};
         std::string txt;
         if (!gclReadWholeText(filePath, txt)) return {};
-        size_t pos=0, s=0;
-        while (pos<=txt.size()){
-            if (pos==txt.size() || txt[pos]=='\n' || txt[pos]=='\r'){
-                std::string line = txt.substr(s, pos-s);
-                std::string path;
-                bool enabled = false;
-                if (gclExtractCategoryLitePathFromLine(line, arkPluginsTxt, path, enabled)) {
-                    if (!enabledOnly || enabled) return path;
-                }
-                if (pos+1<txt.size() && txt[pos]=='\r' && txt[pos+1]=='\n') ++pos;
-                s = pos + 1;
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            std::string path;
+            bool enabled = false;
+            if (gclExtractCategoryLitePathFromLine(line, arkPluginsTxt, path, enabled)) {
+                if (!enabledOnly || enabled) return path;
             }
-            ++pos;
         }
         return {};
     }
@@ -1199,15 +1342,10 @@
         std::string plugins = gclFindArkPluginsFile(arkSe);
         if (!plugins.empty()){
             std::string txt; if (gclReadWholeText(plugins, txt)) {
-                size_t pos=0, s=0;
-                while (pos<=txt.size()){
-                    if (pos==txt.size() || txt[pos]=='\n' || txt[pos]=='\r'){
-                        std::string line = txt.substr(s, pos-s);
-                        if (gclLineEnables(line, true)) { arkEnabled = true; break; }
-                        if (pos+1<txt.size() && txt[pos]=='\r' && txt[pos+1]=='\n') ++pos;
-                        s = pos + 1;
-                    }
-                    ++pos;
+                KfeLineCursor lines(txt);
+                KfeTextSpan line;
+                while (lines.next(line)) {
+                    if (gclLineEnables(line, true)) { arkEnabled = true; break; }
                 }
             }
         }
@@ -1218,15 +1356,10 @@
         std::string vsh = gclFindProVshFile(proSe);
         if (!vsh.empty()){
             std::string txt; if (gclReadWholeText(vsh, txt)) {
-                size_t pos=0, s=0;
-                while (pos<=txt.size()){
-                    if (pos==txt.size() || txt[pos]=='\n' || txt[pos]=='\r'){
-                        std::string line = txt.substr(s, pos-s);
-                        if (gclLineEnables(line, false)) { proEnabled = true; break; }
-                        if (pos+1<txt.size() && txt[pos]=='\r' && txt[pos+1]=='\n') ++pos;
-                        s = pos + 1;
-                    }
-                    ++pos;
+                KfeLineCursor lines(txt);
+                KfeTextSpan line;
+                while (lines.next(line)) {
+                    if (gclLineEnables(line, false)) { proEnabled = true; break; }
                 }
             }
         }
@@ -1384,15 +1517,10 @@
         std::string txt;
         if (!gclReadWholeText(filePath, txt)) return false;
 
-        size_t pos=0, s=0;
-        while (pos<=txt.size()){
-            if (pos==txt.size() || txt[pos]=='\n' || txt[pos]=='\r'){
-                std::string line = txt.substr(s, pos-s);
-                if (gclLineEnables(line, arkPluginsTxt)) return true;
-                if (pos+1<txt.size() && txt[pos]=='\r' && txt[pos+1]=='\n') ++pos;
-                s = pos + 1;
-            }
-            ++pos;
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            if (gclLineEnables(line, arkPluginsTxt)) return true;
         }
         return false;
     }
@@ -1434,6 +1562,15 @@
         return in.substr(a, b - a);
     }
 
+    // "ms0" / "ef0" (optionally "ms0:") -> device root; anything else is rejected.
+    static bool gclParseDeviceToken(KfeTextSpan tok, std::string& outRoot) {
+        tok = kfeSpanTrim(tok);
+        if (tok.n >= 4 && tok[3] == ':') tok = tok.sub(0, 3);
+        if (kfeSpanEqNoCase(tok, "ms0")) { outRoot = "ms0:/"; return true; }
+        if (kfeSpanEqNoCase(tok, "ef0")) { outRoot = "ef0:/"; return true; }
+        return false;
+    }
+
     static std::string gclFilterRootKeyFor(const std::string& dev) {
         std::string key = rootPrefix(dev);
         if (!key.empty()) return key;
@@ -1487,56 +1624,44 @@
         return t;
     }
 
-    static bool updateGameFilterEntryExact(std::vector<std::string>& list,
+    // Rebuild list from 'items' in order, dropping case-insensitive duplicates;
+    // goes through addUniqueFolded so the folded index stays in sync.
+    static void rebuildFilterListDedup(KfeNameList& list, const std::vector<std::string>& items) {
+        list.clear();
+        for (const auto& w : items) list.addUniqueFolded(w);
+    }
+
+    static bool updateGameFilterEntryExact(KfeNameList& list,
                                            const std::string& oldNorm,
                                            const std::string& newNorm) {
         if (oldNorm.empty() || newNorm.empty() || oldNorm == newNorm) return false;
-        bool changed = false;
-        for (auto& w : list) {
-            if (!strcasecmp(w.c_str(), oldNorm.c_str())) {
-                w = newNorm;
-                changed = true;
-            }
+        if (!list.containsFolded(oldNorm)) return false;
+        std::vector<std::string> items = list.items();
+        for (auto& w : items) {
+            if (!strcasecmp(w.c_str(), oldNorm.c_str())) w = newNorm;
         }
-        if (changed) {
-            std::vector<std::string> dedup;
-            dedup.reserve(list.size());
-            for (const auto& w : list) {
-                bool dup = false;
-                for (const auto& d : dedup) { if (!strcasecmp(d.c_str(), w.c_str())) { dup = true; break; } }
-                if (!dup) dedup.push_back(w);
-            }
-            list.swap(dedup);
-        }
-        return changed;
+        rebuildFilterListDedup(list, items);
+        return true;
     }
 
-    static bool updateGameFilterEntryPrefix(std::vector<std::string>& list,
+    static bool updateGameFilterEntryPrefix(KfeNameList& list,
                                             const std::string& oldPrefix,
                                             const std::string& newPrefix) {
         if (oldPrefix.empty() || newPrefix.empty() || oldPrefix == newPrefix) return false;
         bool changed = false;
-        for (auto& w : list) {
+        std::vector<std::string> items = list.items();
+        for (auto& w : items) {
             if (w.size() < oldPrefix.size()) continue;
             if (strncasecmp(w.c_str(), oldPrefix.c_str(), oldPrefix.size()) != 0) continue;
             if (w.size() > oldPrefix.size() && w[oldPrefix.size()] != '/') continue;
             w = newPrefix + w.substr(oldPrefix.size());
             changed = true;
         }
-        if (changed) {
-            std::vector<std::string> dedup;
-            dedup.reserve(list.size());
-            for (const auto& w : list) {
-                bool dup = false;
-                for (const auto& d : dedup) { if (!strcasecmp(d.c_str(), w.c_str())) { dup = true; break; } }
-                if (!dup) dedup.push_back(w);
-            }
-            list.swap(dedup);
-        }
+        if (changed) rebuildFilterListDedup(list, items);
         return changed;
     }
 
-    static bool removeGameFilterEntryExact(std::vector<std::string>& list,
+    static bool removeGameFilterEntryExact(KfeNameList& list,
                                            const std::string& key) {
         if (key.empty()) return false;
         bool changed = false;
@@ -1547,7 +1672,7 @@
         return changed;
     }
 
-    static bool removeGameFilterEntriesByPrefix(std::vector<std::string>& list,
+    static bool removeGameFilterEntriesByPrefix(KfeNameList& list,
                                                 const std::string& prefix) {
         if (prefix.empty()) return false;
         bool changed = false;
@@ -1561,7 +1686,7 @@
         return changed;
     }
 
-    static bool updateListEntryCaseInsensitive(std::vector<std::string>& list,
+    static bool updateListEntryCaseInsensitive(KfeNameList& list,
                                                const std::string& oldValue,
                                                const std::string& newValue) {
         if (oldValue.empty() || newValue.empty()) return false;
@@ -1582,7 +1707,7 @@
         return true;
     }
 
-    static bool replaceCaseInsensitiveEntryWithExact(std::vector<std::string>& list,
+    static bool replaceCaseInsensitiveEntryWithExact(KfeNameList& list,
                                                      const std::string& value) {
         if (value.empty()) return false;
         int matches = 0;
@@ -1604,7 +1729,7 @@
         return true;
     }
 
-    static bool removeListEntryCaseInsensitive(std::vector<std::string>& list,
+    static bool removeListEntryCaseInsensitive(KfeNameList& list,
                                                const std::string& value) {
         if (value.empty()) return false;
         bool changed = false;
@@ -1665,7 +1790,7 @@
                 if (!dup) dedup.push_back(n);
             }
 
-            gclWriteLegacyFilter(dedup);
+            gclSaveLegacyFilter(dedup);
             gclLegacyFilterCache = dedup;
             gclLegacyFilterLoaded = true;
             return true;
@@ -1759,116 +1884,80 @@
         enum Section { SEC_None, SEC_Blacklist, SEC_HiddenCats, SEC_HiddenApps };
         Section sec = SEC_None;
 
-        auto parseDeviceToken = [&](std::string tok, std::string& outRoot)->bool {
-            tok = trimSpaces(tok);
-            if (tok.size() >= 4 && tok[3] == ':') tok = tok.substr(0, 3);
-            for (char& c : tok) c = toLowerC(c);
-            if (tok == "ms0") { outRoot = "ms0:/"; return true; }
-            if (tok == "ef0") { outRoot = "ef0:/"; return true; }
-            return false;
-        };
-
-        auto addUniqueCaseInsensitive = [&](std::vector<std::string>& list, const std::string& v){
-            for (const auto& w : list) {
-                if (!strcasecmp(w.c_str(), v.c_str())) return;
-            }
-            list.push_back(v);
-        };
-
-        auto addUniqueExact = [&](std::vector<std::string>& list, const std::string& v){
-            for (const auto& w : list) {
-                if (!strcasecmp(w.c_str(), v.c_str())) return;
+        auto addUniqueCaseInsensitive = [&](KfeNameList& list, const std::string& v){ list.addUniqueFolded(v); };
+        auto addUniqueExact           = [&](KfeNameList& list, const std::string& v){ list.addUniqueFolded(v); };
+        auto addCategoryEntry = [&](const std::string& root, KfeTextSpan rawVal){
+            std::string val = rawVal.str();
+            if (sec == SEC_Blacklist) {
+                val = normalizeBlacklistInput(val);
+                if (val.empty()) return;
+                if (root.empty()) {
+                    addUniqueCaseInsensitive(gclBlacklistMap["ms0:/"], val);
+                    addUniqueCaseInsensitive(gclBlacklistMap["ef0:/"], val);
+                } else {
+                    addUniqueCaseInsensitive(gclBlacklistMap[root], val);
+                }
+            } else {
+                val = stripCategoryPrefixes(val);
+                if (val.empty()) return;
+                if (root.empty()) {
+                    addUniqueCaseInsensitive(gclCategoryFilterMap["ms0:/"], val);
+                    addUniqueCaseInsensitive(gclCategoryFilterMap["ef0:/"], val);
+                } else {
+                    addUniqueCaseInsensitive(gclCategoryFilterMap[root], val);
+                }
             }
-            list.push_back(v);
         };
 
-        size_t pos = 0, start = 0;
-        while (pos <= txt.size()) {
-            if (pos == txt.size() || txt[pos] == '\n' || txt[pos] == '\r') {
-                std::string raw = trimSpaces(txt.substr(start, pos - start));
-                if (!raw.empty()) {
-                    std::string low = raw;
-                    for (char& c : low) c = toLowerC(c);
-                    if (low.rfind("===", 0) == 0 && low.size() >= 6 && low.find("===") != std::string::npos) {
-                        if (low == "===categories rename blacklist===") sec = SEC_Blacklist;
-                        else if (low == "===hidden categories===") sec = SEC_HiddenCats;
-                        else if (low == "===hidden apps===") sec = SEC_HiddenApps;
-                        else sec = SEC_None;
-                    } else if (sec == SEC_Blacklist || sec == SEC_HiddenCats) {
-                        size_t comma = raw.find(',');
-                        bool parsed = false;
-                        if (comma != std::string::npos) {
-                            std::string devTok = raw.substr(0, comma);
-                            std::string val = trimSpaces(raw.substr(comma + 1));
-                            std::string root;
-                            if (parseDeviceToken(devTok, root) && !val.empty()) {
-                                parsed = true;
-                                if (sec == SEC_Blacklist) {
-                                    val = normalizeBlacklistInput(val);
-                                    if (!val.empty()) addUniqueCaseInsensitive(gclBlacklistMap[root], val);
-                                } else {
-                                    val = stripCategoryPrefixes(val);
-                                    if (!val.empty()) addUniqueCaseInsensitive(gclCategoryFilterMap[root], val);
-                                }
-                            }
-                        } else if (raw.size() >= 4 && (raw[3] == ':' || raw[3] == ' ' || raw[3] == '\t')) {
-                            std::string devTok = raw.substr(0, 3);
-                            std::string val = trimSpaces(raw.substr(4));
-                            std::string root;
-                            if (parseDeviceToken(devTok, root) && !val.empty()) {
-                                parsed = true;
-                                if (sec == SEC_Blacklist) {
-                                    val = normalizeBlacklistInput(val);
-                                    if (!val.empty()) addUniqueCaseInsensitive(gclBlacklistMap[root], val);
-                                } else {
-                                    val = stripCategoryPrefixes(val);
-                                    if (!val.empty()) addUniqueCaseInsensitive(gclCategoryFilterMap[root], val);
-                                }
-                            }
-                        }
-                        if (!parsed) {
-                            std::string val = raw;
-                            if (sec == SEC_Blacklist) {
-                                val = normalizeBlacklistInput(val);
-                                if (!val.empty()) {
-                                    addUniqueCaseInsensitive(gclBlacklistMap["ms0:/"], val);
-                                    addUniqueCaseInsensitive(gclBlacklistMap["ef0:/"], val);
-                                }
-                            } else {
-                                val = stripCategoryPrefixes(val);
-                                if (!val.empty()) {
-                                    addUniqueCaseInsensitive(gclCategoryFilterMap["ms0:/"], val);
-                                    addUniqueCaseInsensitive(gclCategoryFilterMap["ef0:/"], val);
-                                }
-                            }
-                        }
-                    } else if (sec == SEC_HiddenApps) {
-                        std::string devTok, pathPart;
-                        size_t comma = raw.find(',');
-                        if (comma != std::string::npos) {
-                            devTok = raw.substr(0, comma);
-                            pathPart = trimSpaces(raw.substr(comma + 1));
-                        } else if (raw.size() >= 4 && raw[3] == ':') {
-                            devTok = raw.substr(0, 3);
-                            pathPart = raw;
-                        }
-                        std::string root;
-                        if (!devTok.empty() && parseDeviceToken(devTok, root)) {
-                            std::string norm = normalizeGameFilterPath(pathPart);
-                            if (!norm.empty()) addUniqueExact(gclGameFilterMap[root], norm);
-                        } else if (devTok.empty()) {
-                            std::string norm = normalizeGameFilterPath(raw);
-                            if (!norm.empty()) {
-                                addUniqueExact(gclGameFilterMap["ms0:/"], norm);
-                                addUniqueExact(gclGameFilterMap["ef0:/"], norm);
-                            }
-                        }
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            KfeTextSpan raw = kfeSpanTrim(line);
+            if (raw.empty()) continue;
+            if (raw.n >= 6 && kfeSpanStartsNoCase(raw, "===")) {
+                if (kfeSpanEqNoCase(raw, "===categories rename blacklist===")) sec = SEC_Blacklist;
+                else if (kfeSpanEqNoCase(raw, "===hidden categories===")) sec = SEC_HiddenCats;
+                else if (kfeSpanEqNoCase(raw, "===hidden apps===")) sec = SEC_HiddenApps;
+                else sec = SEC_None;
+            } else if (sec == SEC_Blacklist || sec == SEC_HiddenCats) {
+                size_t comma = raw.find(',');
+                bool parsed = false;
+                KfeTextSpan devTok, val;
+                if (comma != std::string::npos) {
+                    devTok = raw.sub(0, comma);
+                    val = kfeSpanTrim(raw.sub(comma + 1));
+                } else if (raw.n >= 4 && (raw[3] == ':' || raw[3] == ' ' || raw[3] == '\t')) {
+                    devTok = raw.sub(0, 3);
+                    val = kfeSpanTrim(raw.sub(4));
+                }
+                std::string root;
+                if (!devTok.empty() && gclParseDeviceToken(devTok, root) && !val.empty()) {
+                    parsed = true;
+                    addCategoryEntry(root, val);
+                }
+                if (!parsed) addCategoryEntry(std::string(), raw);
+            } else if (sec == SEC_HiddenApps) {
+                KfeTextSpan devTok, pathPart;
+                size_t comma = raw.find(',');
+                if (comma != std::string::npos) {
+                    devTok = raw.sub(0, comma);
+                    pathPart = kfeSpanTrim(raw.sub(comma + 1));
+                } else if (raw.n >= 4 && raw[3] == ':') {
+                    devTok = raw.sub(0, 3);
+                    pathPart = raw;
+                }
+                std::string root;
+                if (!devTok.empty() && gclParseDeviceToken(devTok, root)) {
+                    std::string norm = normalizeGameFilterPath(pathPart.str());
+                    if (!norm.empty()) addUniqueExact(gclGameFilterMap[root], norm);
+                } else if (devTok.empty()) {
+                    std::string norm = normalizeGameFilterPath(raw.str());
+                    if (!norm.empty()) {
+                        addUniqueExact(gclGameFilterMap["ms0:/"], norm);
+                        addUniqueExact(gclGameFilterMap["ef0:/"], norm);
                     }
                 }
-                if (pos + 1 < txt.size() && txt[pos] == '\r' && txt[pos+1] == '\n') ++pos;
-                start = pos + 1;
             }
-            ++pos;
         }
 
         // Blacklist lives in its own file in the EBOOT folder.
@@ -1883,7 +1972,53 @@
         }
     }
 
+    // ---------------------------------------------------------------
+    // Filter write-behind. While a GclFilterBatch is open, saves only mark
+    // the in-memory lists dirty; the outermost batch writes each file once.
+    // ---------------------------------------------------------------
+    struct GclFilterBatch {
+        GclFilterBatch() { ++gclFilterBatchDepth; }
+        ~GclFilterBatch() {
+            if (--gclFilterBatchDepth > 0) return;
+            gclFlushFilters();
+            if (gKfeExitRequested) sceKernelExitGame();   // HOME arrived mid-batch
+        }
+        GclFilterBatch(const GclFilterBatch&) = delete;
+        GclFilterBatch& operator=(const GclFilterBatch&) = delete;
+    };
+
+    static void gclFlushFilters() {
+        if (gclUnifiedFiltersDirty) gclWriteUnifiedFilters();
+        if (gclLegacyFilterDirty) {
+            gclLegacyFilterDirty = false;
+            gclWriteLegacyFilter(gclLegacyFilterPending);
+            gclLegacyFilterPending.clear();
+        }
+    }
+
+    // Pending edits must reach the card before the lists are re-read from it.
+    void gclReloadFiltersOnNextUse() {
+        gclFlushFilters();
+        gclFiltersLoaded = false;
+        gclLegacyFilterLoaded = false;
+    }
+
     static bool gclSaveUnifiedFilters() {
+        if (gclFilterBatchDepth > 0) { gclUnifiedFiltersDirty = true; return true; }
+        return gclWriteUnifiedFilters();
+    }
+
+    static bool gclSaveLegacyFilter(const std::vector<std::string>& names) {
+        if (gclFilterBatchDepth > 0) {
+            gclLegacyFilterPending = names;
+            gclLegacyFilterDirty = true;
+            return true;
+        }
+        return gclWriteLegacyFilter(names);
+    }
+
+    static bool gclWriteUnifiedFilters() {
+        gclUnifiedFiltersDirty = false;
         if (!gclFiltersLoaded) gclLoadUnifiedFilters();
 
         // Blacklist always goes to its own file in the EBOOT folder
@@ -2036,23 +2171,14 @@
         std::vector<std::string> names;
         std::string txt;
         if (!gclReadWholeText(filePath, txt)) return names;
-        size_t pos = 0, start = 0;
-        while (pos <= txt.size()) {
-            if (pos == txt.size() || txt[pos] == '\n' || txt[pos] == '\r') {
-                std::string raw = trimSpaces(txt.substr(start, pos - start));
-                std::string name = extractLegacyFolderName(raw);
-                if (!name.empty()) {
-                    // Deduplicate (case-sensitive)
-                    bool dup = false;
-                    for (const auto& existing : names) {
-                        if (existing == name) { dup = true; break; }
-                    }
-                    if (!dup) names.push_back(name);
-                }
-                if (pos + 1 < txt.size() && txt[pos] == '\r' && txt[pos + 1] == '\n') ++pos;
-                start = pos + 1;
-            }
-            ++pos;
+        std::unordered_set<std::string> seen;   // deduplicate (case-sensitive)
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            KfeTextSpan raw = kfeSpanTrim(line);
+            if (raw.empty()) continue;
+            std::string name = extractLegacyFolderName(raw.str());
+            if (!name.empty() && seen.insert(name).second) names.push_back(name);
         }
         return names;
     }
@@ -2114,7 +2240,7 @@
                 }
             }
         }
-        gclWriteLegacyFilter(names);
+        gclSaveLegacyFilter(names);
         gclLegacyFilterCache = names;  // update cache in place
     }
 
@@ -2136,51 +2262,52 @@
             results.push_back(p);
         };
 
-        auto searchDevice = [&](const char* root) {
-            if (!DeviceExists(root)) return;
-            std::string gameDir = std::string(root) + "PSP/GAME";
-            if (!dirExists(gameDir)) return;
-            SceUID d = kfeIoOpenDir(gameDir.c_str());
+        // Subdirectory names of dir, from the listing cache when a scope is active.
+        auto listSubdirNames = [](const std::string& dir, std::vector<std::string>& out) {
+            if (const KfeDirListing* L = kfeDirCacheListing(dir)) {
+                for (const auto& e : L->entries)
+                    if (FIO_S_ISDIR(e.mode)) out.push_back(e.name);
+                return;
+            }
+            SceUID d = kfeIoOpenDir(dir.c_str());
             if (d < 0) return;
-
             SceIoDirent ent; memset(&ent, 0, sizeof(ent));
             while (kfeIoReadDir(d, &ent) > 0) {
                 trimTrailingSpaces(ent.d_name);
-                if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) { memset(&ent, 0, sizeof(ent)); continue; }
-                if (!FIO_S_ISDIR(ent.d_stat.st_mode)) { memset(&ent, 0, sizeof(ent)); continue; }
+                if (strcmp(ent.d_name, ".") && strcmp(ent.d_name, "..") && FIO_S_ISDIR(ent.d_stat.st_mode))
+                    out.push_back(ent.d_name);
+                memset(&ent, 0, sizeof(ent));
+            }
+            kfeIoCloseDir(d);
+        };
+
+        auto searchDevice = [&](const char* root) {
+            if (!DeviceExists(root)) return;
+            std::string gameDir = std::string(root) + "PSP/GAME";
+            if (!dirExists(gameDir)) return;
 
-                std::string child = joinDirFile(gameDir, ent.d_name);
+            std::vector<std::string> children;
+            listSubdirNames(gameDir, children);
+            for (const auto& name : children) {
+                std::string child = joinDirFile(gameDir, name.c_str());
                 const bool childIsGameFolder = !findEbootCaseInsensitive(child).empty();
 
                 // /PSP/GAME/<App>
-                if (!strcasecmp(ent.d_name, folderName.c_str()) && childIsGameFolder) {
+                if (!strcasecmp(name.c_str(), folderName.c_str()) && childIsGameFolder) {
                     pushUnique(child);
                 }
 
                 // /PSP/GAME/<Category>/<App> (one level only)
                 if (!childIsGameFolder) {
-                    SceUID d2 = kfeIoOpenDir(child.c_str());
-                    if (d2 >= 0) {
-                        SceIoDirent ent2; memset(&ent2, 0, sizeof(ent2));
-                        while (kfeIoReadDir(d2, &ent2) > 0) {
-                            trimTrailingSpaces(ent2.d_name);
-                            if (!strcmp(ent2.d_name, ".") || !strcmp(ent2.d_name, "..")) { memset(&ent2, 0, sizeof(ent2)); continue; }
-                            if (!FIO_S_ISDIR(ent2.d_stat.st_mode)) { memset(&ent2, 0, sizeof(ent2)); continue; }
-
-                            if (!strcasecmp(ent2.d_name, folderName.c_str())) {
-                                std::string appPath = joinDirFile(child, ent2.d_name);
-                                if (!findEbootCaseInsensitive(appPath).empty()) {
-                                    pushUnique(appPath);
-                                }
-                            }
-                            memset(&ent2, 0, sizeof(ent2));
+                    std::string app = kfeFindNameCaseInsensitive(child, folderName.c_str(), KFE_DC_DIR);
+                    if (!app.empty()) {
+                        std::string appPath = joinDirFile(child, app.c_str());
+                        if (!findEbootCaseInsensitive(appPath).empty()) {
+                            pushUnique(appPath);
                         }
-                        kfeIoCloseDir(d2);
                     }
                 }
-                memset(&ent, 0, sizeof(ent));
             }
-            kfeIoCloseDir(d);
         };
 
         searchDevice("ms0:/");
@@ -2193,51 +2320,36 @@
         // Returns pairs of (device root, normalized path)
         std::vector<std::pair<std::string, std::string>> results;
         bool inHiddenApps = false;
-        size_t pos = 0, start = 0;
-        while (pos <= txt.size()) {
-            if (pos == txt.size() || txt[pos] == '\n' || txt[pos] == '\r') {
-                std::string raw = trimSpaces(txt.substr(start, pos - start));
-                if (!raw.empty()) {
-                    std::string low = raw;
-                    for (char& c : low) c = toLowerC(c);
-                    if (low.rfind("===", 0) == 0) {
-                        inHiddenApps = (low == "===hidden apps===");
-                    } else if (inHiddenApps) {
-                        // Parse device + path
-                        std::string devTok, pathPart;
-                        size_t comma = raw.find(',');
-                        if (comma != std::string::npos) {
-                            devTok = raw.substr(0, comma);
-                            pathPart = trimSpaces(raw.substr(comma + 1));
-                        } else if (raw.size() >= 4 && raw[3] == ':') {
-                            devTok = raw.substr(0, 3);
-                            pathPart = raw;
-                        }
-                        std::string root;
-                        auto parseDevTok = [](std::string tok, std::string& r) -> bool {
-                            for (char& c : tok) if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
-                            if (tok.size() >= 4 && tok[3] == ':') tok = tok.substr(0, 3);
-                            while (!tok.empty() && (tok.back() == ' ' || tok.back() == '\t')) tok.pop_back();
-                            if (tok == "ms0") { r = "ms0:/"; return true; }
-                            if (tok == "ef0") { r = "ef0:/"; return true; }
-                            return false;
-                        };
-                        if (!devTok.empty() && parseDevTok(devTok, root)) {
-                            std::string norm = normalizeGameFilterPath(pathPart);
-                            if (!norm.empty()) results.push_back({root, norm});
-                        } else if (devTok.empty()) {
-                            std::string norm = normalizeGameFilterPath(raw);
-                            if (!norm.empty()) {
-                                results.push_back({"ms0:/", norm});
-                                results.push_back({"ef0:/", norm});
-                            }
-                        }
+        KfeLineCursor lines(txt);
+        KfeTextSpan line;
+        while (lines.next(line)) {
+            KfeTextSpan raw = kfeSpanTrim(line);
+            if (raw.empty()) continue;
+            if (kfeSpanStartsNoCase(raw, "===")) {
+                inHiddenApps = kfeSpanEqNoCase(raw, "===hidden apps===");
+            } else if (inHiddenApps) {
+                // Parse device + path
+                KfeTextSpan devTok, pathPart;
+                size_t comma = raw.find(',');
+                if (comma != std::string::npos) {
+                    devTok = raw.sub(0, comma);
+                    pathPart = kfeSpanTrim(raw.sub(comma + 1));
+                } else if (raw.n >= 4 && raw[3] == ':') {
+                    devTok = raw.sub(0, 3);
+                    pathPart = raw;
+                }
+                std::string root;
+                if (!devTok.empty() && gclParseDeviceToken(devTok, root)) {
+                    std::string norm = normalizeGameFilterPath(pathPart.str());
+                    if (!norm.empty()) results.push_back({root, norm});
+                } else if (devTok.empty()) {
+                    std::string norm = normalizeGameFilterPath(raw.str());
+                    if (!norm.empty()) {
+                        results.push_back({"ms0:/", norm});
+                        results.push_back({"ef0:/", norm});
                     }
                 }
-                if (pos + 1 < txt.size() && txt[pos] == '\r' && txt[pos + 1] == '\n') ++pos;
-                start = pos + 1;
             }
-            ++pos;
         }
         return results;
     }
@@ -2284,7 +2396,7 @@
             if (legacyNames.empty()) return;
 
             // Force-reload the v1.8 filter maps so we have current state
-            gclFiltersLoaded = false; gclLegacyFilterLoaded = false;
+            gclReloadFiltersOnNextUse();
 
             // If dest doesn't exist yet, create an empty v1.8 file
             if (!pathExists(destFile)) {
@@ -2293,6 +2405,7 @@
 
             gclLoadUnifiedFilters();
 
+            KfeDirCacheScope dirCache;   // every name probes the same PSP/GAME trees
             for (const auto& name : legacyNames) {
                 if (name.empty() || name.rfind("===", 0) == 0) continue;
                 std::vector<std::string> found = gclFindGameFoldersByName(name);
@@ -2300,12 +2413,8 @@
                     // Fallback: add as /PSP/GAME/<name> for both devices
                     std::string fallback = normalizeGameFilterPath("/PSP/GAME/" + name);
                     if (!fallback.empty()) {
-                        auto addUnique = [](std::vector<std::string>& list, const std::string& v) {
-                            for (const auto& w : list) if (!strcasecmp(w.c_str(), v.c_str())) return;
-                            list.push_back(v);
-                        };
-                        addUnique(gclGameFilterMap["ms0:/"], fallback);
-                        addUnique(gclGameFilterMap["ef0:/"], fallback);
+                        gclGameFilterMap["ms0:/"].addUniqueFolded(fallback);
+                        gclGameFilterMap["ef0:/"].addUniqueFolded(fallback);
                     }
                 } else {
                     for (const auto& fullPath : found) {
@@ -2313,11 +2422,7 @@
                         if (root.empty()) root = "ms0:/";
                         std::string norm = normalizeGameFilterPath(fullPath);
                         if (norm.empty()) continue;
-                        auto addUnique = [](std::vector<std::string>& list, const std::string& v) {
-                            for (const auto& w : list) if (!strcasecmp(w.c_str(), v.c_str())) return;
-                            list.push_back(v);
-                        };
-                        addUnique(gclGameFilterMap[root], norm);
+                        gclGameFilterMap[root].addUniqueFolded(norm);
                     }
                 }
             }
@@ -2373,7 +2478,7 @@
             }
             if (!out.empty()) {
                 gclWriteWholeText(repairLegacy, out);
-                gclFiltersLoaded = false; gclLegacyFilterLoaded = false;
+                gclReloadFiltersOnNextUse();
                 gclMergeLegacyFilters(repairLegacy, path, /*toLegacy=*/false);
                 sceIoRemove(repairLegacy.c_str());
             }
@@ -2387,6 +2492,7 @@
 
     bool gclForceRemoveFile(const std::string& path) {
         if (path.empty() || !pathExists(path)) return true;
+        kfeDigestForget();
         return sceIoRemove(path.c_str()) >= 0;
     }
 
@@ -2406,39 +2512,14 @@
         return (rd == 4 && hdr[0] == 0x7F && hdr[1] == 'E' && hdr[2] == 'L' && hdr[3] == 'F');
     }
 
-    static bool gclFilesBinaryEqual(const std::string& a, const std::string& b) {
-        SceIoStat sa{}, sb{};
-        if (!pathExists(a, &sa) || !pathExists(b, &sb)) return false;
-        if (sa.st_size != sb.st_size) return false;
-
-        SceUID fa = sceIoOpen(a.c_str(), PSP_O_RDONLY, 0);
-        if (fa < 0) return false;
-        SceUID fb = sceIoOpen(b.c_str(), PSP_O_RDONLY, 0);
-        if (fb < 0) { sceIoClose(fa); return false; }
-
-        char ba[16 * 1024];
-        char bb[16 * 1024];
-        bool ok = true;
-        for (;;) {
-            int ra = sceIoRead(fa, ba, sizeof(ba));
-            int rb = sceIoRead(fb, bb, sizeof(bb));
-            if (ra != rb) { ok = false; break; }
-            if (ra < 0) { ok = false; break; }
-            if (ra == 0) break;
-            if (memcmp(ba, bb, (size_t)ra) != 0) { ok = false; break; }
-        }
-        sceIoClose(fa);
-        sceIoClose(fb);
-        return ok;
-    }
-
     static bool gclVerifyPrxInstall(const std::string& src, const std::string& dst) {
         if (!gclVerifyPrxHeader(dst)) return false;
-        return gclFilesBinaryEqual(src, dst);
+        return gclFilesSameDigest(src, dst);
     }
 
     bool gclForceCopyFile(const std::string& src, const std::string& dst) {
         if (src.empty() || dst.empty() || !pathExists(src)) return false;
+        kfeDigestForget();
         const bool isPrx = gclIsPrxPath(src) || gclIsPrxPath(dst);
         if (strcasecmp(src.c_str(), dst.c_str()) == 0) {
             return isPrx ? gclVerifyPrxHeader(dst) : true;
@@ -2483,6 +2564,7 @@
 
     bool gclForceMoveFile(const std::string& src, const std::string& dst) {
         if (src.empty() || dst.empty() || !pathExists(src)) return false;
+        kfeDigestForget();
         const bool isPrx = gclIsPrxPath(src) || gclIsPrxPath(dst);
         if (strcasecmp(src.c_str(), dst.c_str()) == 0) {
             return isPrx ? gclVerifyPrxHeader(dst) : true;
@@ -2710,7 +2792,7 @@
         if (pathExists(prxActive)) gclPrxPath = prxActive;
         gclOldPrxPath = pathExists(prxOld) ? prxOld : std::string();
         gclLegacyMode = enableLegacy;
-        gclFiltersLoaded = false; gclLegacyFilterLoaded = false;
+        gclReloadFiltersOnNextUse();
     }
 
     // Detect whether boot should migrate a legacy (headerless) filter file.
@@ -2740,7 +2822,7 @@
         }
 
         // Merge old entries into a fresh v1.8 filter
-        gclFiltersLoaded = false; gclLegacyFilterLoaded = false;
+        gclReloadFiltersOnNextUse();
         gclMergeLegacyFilters(oldPath, filterPath, /*toLegacy=*/false);
         gclRepairV18FilterFileIfNeeded(filterPath);
     }
@@ -2749,11 +2831,7 @@
         if (base.empty() || !blacklistActive()) return false;
         gclLoadUnifiedFilters();
         const auto& bl = gclBlacklistMap[blacklistRootKey(root)];
-        for (const auto& w : bl) {
-            if (w.empty()) continue;
-            if (!strcasecmp(base.c_str(), w.c_str())) return true;
-        }
-        return false;
+        return bl.containsFolded(base);
     }
 
     bool isBlacklistedBaseName(const std::string& base) {
@@ -2785,10 +2863,7 @@
         gclLoadCategoryFilterFor(currentDevice);
         const std::string root = gclFilterRootKeyFor(currentDevice);
         const auto& fl = gclCategoryFilterMap[root];
-        for (const auto& w : fl) {
-            if (!strcasecmp(w.c_str(), base.c_str())) return true;
-        }
-        return false;
+        return fl.containsFolded(base);
     }
 
     void refreshGclFilterFile() {
@@ -2859,10 +2934,7 @@
         gclLoadGameFilterFor(currentDevice);
         const std::string root = gclFilterRootKeyFor(currentDevice);
         const auto& fl = gclGameFilterMap[root];
-        for (const auto& w : fl) {
-            if (!strcasecmp(w.c_str(), key.c_str())) return true;
-        }
-        return false;
+        return fl.containsFolded(key);
     }
 
     void setGameHiddenForPaths(const std::vector<std::string>& paths, bool hide) {
@@ -2876,11 +2948,7 @@
             std::string key = normalizeGameFilterPath(p);
             if (key.empty()) continue;
             if (hide) {
-                bool exists = false;
-                for (const auto& w : fl) {
-                    if (!strcasecmp(w.c_str(), key.c_str())) { exists = true; break; }
-                }
-                if (!exists) fl.push_back(key);
+                fl.addUniqueFolded(key);
             } else {
                 for (auto it = fl.begin(); it != fl.end(); ) {
                     if (!strcasecmp(it->c_str(), key.c_str())) it = fl.erase(it);
@@ -2892,7 +2960,9 @@
     }
 
     void applyBlacklistChanges() {
+        GclFilterBatch filterBatch;
         gclSaveBlacklistFor(currentDevice);
+        KfeCatTopoScope catTopo;   // enforcement and the refreshes below share one listing per root
 
         if (!blacklistActive()) {
             gclPendingUnblacklistMap[blacklistRootKey(currentDevice)].clear();
@@ -3217,16 +3287,23 @@
         SceUID out = sceIoOpen(dst.c_str(), PSP_O_WRONLY | PSP_O_CREAT | PSP_O_TRUNC, 0777);
         if (out < 0) { sceIoClose(in); return false; }
 
-        char buf[16 * 1024];
-        for (;;) {
-            int rd = sceIoRead(in, buf, sizeof(buf));
-            if (rd < 0) { sceIoClose(in); sceIoClose(out); return false; }
+        // PRX/filter files are tiny: fall back to 16 KiB if the pool can't allocate.
+        size_t bufSize = 0;
+        uint8_t* buf = kfeIoBufferAcquire(kfeIoBufferSizeFor(src, dst), bufSize);
+        const bool pooled = (buf != nullptr);
+        if (!pooled) { bufSize = 16 * 1024; buf = (uint8_t*)malloc(bufSize); }
+        bool ok = (buf != nullptr);
+        while (ok) {
+            int rd = sceIoRead(in, buf, (SceSize)bufSize);
+            if (rd < 0) { ok = false; break; }
             if (rd == 0) break;
             int wr = sceIoWrite(out, buf, rd);
-            if (wr != rd) { sceIoClose(in); sceIoClose(out); return false; }
+            if (wr != rd) ok = false;
         }
+        if (pooled) kfeIoBufferRelease();
+        else free(buf);
         sceIoClose(in); sceIoClose(out);
-        return true;
+        return ok;
     }
 
     // Ensure category_lite.prx exists under <root>/SEPLUGINS
@@ -3278,7 +3355,7 @@
         std::string baseDir = currentExecBaseDir();
         std::string src = baseDir + "resources/category_lite.prx";
         if (!pathExists(src, &srcSt) || !pathExists(gclPrxPath, &curSt)) return;
-        if (srcSt.st_size == curSt.st_size) return;
+        if (gclFilesSameDigest(src, gclPrxPath)) return;
 
         std::string dir = parentOf(gclPrxPath);
         if (dir.empty()) return;
@@ -3379,6 +3456,7 @@
     // Run after USB disconnect to recover from host-side edits/races that can
     // leave plugin binaries truncated or malformed.
     void gclRunPostUsbIntegrityHeal() {
+        kfeDigestForget();   // the PC may have rewritten plugins with matching size/mtime
         gclComputeInitial();
 
         const bool preferArkBackend = gclArkOn || !gclProOn;
@@ -3429,7 +3507,7 @@
     void buildRootRows(){
         clearUI();
         int preselect = -1;
-        const uint64_t HEADROOM = (4ull << 20); // keep ~4 MiB headroom
+        const uint64_t HEADROOM = (1ull << 20); // ~1 MiB for FAT updates; need already counts cluster slack
 
         bool hasMs = false, hasEf = false;
         for (auto &r : roots) {
@@ -3605,8 +3683,10 @@
                 if (opPhase == OP_SelectDevice &&
                     (actionMode == AM_Move || actionMode == AM_Copy)) {
                     if (!sameDeviceMoveRow) {
+                        // Full total (no early stop): the row shows it.
                         needB = bytesNeededForOp(opSrcPaths, opSrcKinds, r, /*isCopy=*/(actionMode == AM_Copy));
-                        if (getFreeBytesCMF(r.c_str(), freeB)) {
+                        // Cached + accounted value; only probes when nothing is known yet.
+                        if (FreeSpaceQuery(r.c_str(), freeB)) {
                             if (needB > 0 && freeB + HEADROOM < needB) {
                                 flags |= ROW_DISABLED;
                                 reason = RD_NO_SPACE;
@@ -3616,7 +3696,7 @@
                         }
                     } else {
                         // Still show actual free space for same-device Move.
-                        getFreeBytesCMF(r.c_str(), freeB);
+                        FreeSpaceQuery(r.c_str(), freeB);
                     }
                 }
             }
@@ -3688,6 +3768,8 @@
             }
             rootKeepGclSelection = false;
         }
+
+        if (actionMode == AM_None) kickDevicePrefetch();
     }
 
 
@@ -3705,7 +3787,7 @@
         {
             const std::string filterRoot = gclFilterRootKeyFor(currentDevice);
             (void)filterRoot;
-            gclFiltersLoaded = false; gclLegacyFilterLoaded = false;
+            gclReloadFiltersOnNextUse();
             gclLoadCategoryFilterFor(currentDevice);
         }
 
@@ -3953,6 +4035,7 @@
             FreeSpaceSetPresence(probeMs, probeEf);     // <--- probe opposite only
             FreeSpaceRequestRefresh();
         }
+        kickDevicePrefetch();   // other root, if its cache line is stale
 
         if (gclArkOn || gclProOn) {
             // RUN-ONCE per device root (ms0:/ or ef0:/). Avoids slow renames when backing out.
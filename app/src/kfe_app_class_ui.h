@@ -79,12 +79,16 @@ private:
     };
     static GclConfig gclCfg;        // initialized out-of-class
     static bool      gclCfgLoaded;  // initialized out-of-class
-    static std::unordered_map<std::string, std::vector<std::string>> gclBlacklistMap;        // key: root ("ms0:/", "ef0:/")
+    static std::unordered_map<std::string, KfeNameList> gclBlacklistMap;        // key: root ("ms0:/", "ef0:/")
     static std::unordered_map<std::string, std::vector<std::string>> gclPendingUnblacklistMap;
-    static std::unordered_map<std::string, std::vector<std::string>> gclCategoryFilterMap;   // key: filter root ("ms0:/", "ef0:/")
-    static std::unordered_map<std::string, std::vector<std::string>> gclGameFilterMap;       // key: filter root ("ms0:/", "ef0:/")
+    static std::unordered_map<std::string, KfeNameList> gclCategoryFilterMap;   // key: filter root ("ms0:/", "ef0:/")
+    static std::unordered_map<std::string, KfeNameList> gclGameFilterMap;       // key: filter root ("ms0:/", "ef0:/")
     static bool gclFiltersLoaded;
     static bool gclFiltersScrubbed;
+    static int  gclFilterBatchDepth;                          // >0: filter saves only mark dirty
+    static bool gclUnifiedFiltersDirty;
+    static bool gclLegacyFilterDirty;
+    static std::vector<std::string> gclLegacyFilterPending;  // names for the deferred legacy write
     static inline bool blacklistActive() { return gclCfg.prefix != 0; }
     bool isUncategorizedEnabledForDevice(const std::string& dev) const {
         if (gclCfg.uncategorized == 0) return false;
@@ -250,8 +254,7 @@ private:
                 std::vector<std::string> subs;
                 listSubdirs(abs, subs);
                 for (auto &sub : subs) {
-                    std::string subAbs = joinDirFile(abs, sub.c_str());
-                    if (!findEbootCaseInsensitive(subAbs).empty()) continue; // skip real games
+                    if (kfeIsGameFolderIn(abs, sub)) continue; // skip real games
                     std::string base = stripCategoryPrefixes(sub, stripNumbers);
                     if (base.empty()) continue;
                     chooseDiskName(base, sub);
@@ -466,6 +469,7 @@ private:
 
     void sortCategoryNamesByMtime(std::vector<std::string>& names, const std::string& dev) const {
         if (names.size() < 2) return;
+        KfeCatTopoScope catTopo;   // one listing per root instead of a stat per name per root
         std::unordered_map<std::string, u64> mt;
         mt.reserve(names.size());
         for (const auto& n : names) {
@@ -488,8 +492,7 @@ private:
             listSubdirs(absRoot, subs); // class-static helper
             for (auto& sub : subs) {
                 // Skip real game folders; only consider category folders
-                std::string subAbs = joinDirFile(absRoot, sub.c_str());
-                if (!findEbootCaseInsensitive(subAbs).empty()) continue; // global helper is already visible
+                if (kfeIsGameFolderIn(absRoot, sub)) continue;
                 if (!strcasecmp(stripCategoryPrefixes(sub).c_str(), base.c_str())) {
                     return sub; // enforced on-disk name we want
                 }
@@ -540,6 +543,7 @@ private:
 
     // Enumerate immediate subfolders under a root.
     static void listSubdirs(const std::string& root, std::vector<std::string>& out){
+        if (kfeCatTopoSubdirs(root, out)) return;   // category root inside an open operation
         forEachEntry(root, [&](const SceIoDirent& e){
             if (FIO_S_ISDIR(e.d_stat.st_mode)){
                 std::string n = e.d_name;
@@ -549,44 +553,52 @@ private:
     }
 
     // Merge src -> dst, preferring existing entries in dst (src duplicates are deleted).
+    // Each side is listed once up front. Children missing from dst move over whole
+    // (instant FAT devctl move, plain rename as fallback); only folders present on
+    // both sides are descended into.
     static bool mergeDirPreferDest(const std::string& srcDir, const std::string& dstDir){
-        if (!dirExists(srcDir) || !dirExists(dstDir)) return false;
-
-        SceUID d = kfeIoOpenDir(srcDir.c_str());
-        if (d < 0) return false;
+        std::vector<std::pair<std::string, bool>> srcKids;        // (name, isDir)
+        std::unordered_map<std::string, bool> dstKids;            // folded name -> isDir
+        {
+            KfeDirReader rs(srcDir.c_str());
+            KfeDirReader rd(dstDir.c_str());
+            if (!rs.ok() || !rd.ok()) return false;
+            SceIoDirent ent;
+            while (rs.next(ent)) {
+                if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) continue;
+                srcKids.emplace_back(ent.d_name, FIO_S_ISDIR(ent.d_stat.st_mode));
+            }
+            while (rd.next(ent)) {
+                if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) continue;
+                dstKids[kfeFoldCase(ent.d_name)] = FIO_S_ISDIR(ent.d_stat.st_mode);
+            }
+        }
 
         bool ok = true;
-        SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-        while (kfeIoReadDir(d, &ent) > 0) {
-            if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) { memset(&ent,0,sizeof(ent)); continue; }
-
-            std::string s = joinDirFile(srcDir, ent.d_name);
-            std::string t = joinDirFile(dstDir, ent.d_name);
-
-            if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
-                if (dirExists(t)) {
-                    if (!mergeDirPreferDest(s, t)) ok = false;
-                    int rr = sceIoRmdir(s.c_str());
-                    if (rr < 0) { ok = false; logf("cat merge: rmdir fail %s rc=%d", s.c_str(), rr); }
-                } else {
-                    int rr = sceIoRename(s.c_str(), t.c_str());
-                    if (rr < 0) { ok = false; logf("cat merge: rename dir fail %s -> %s rc=%d", s.c_str(), t.c_str(), rr); }
-                }
+        for (const auto& kid : srcKids) {
+            std::string s = joinDirFile(srcDir, kid.first.c_str());
+            std::string t = joinDirFile(dstDir, kid.first.c_str());
+            auto hit = dstKids.find(kfeFoldCase(kid.first.c_str()));
+
+            if (hit == dstKids.end()) {
+                int rr = KfeFileOps::kfeFastMoveDevctl(s.c_str(), t.c_str());
+                if (rr < 0) rr = kfeIoRename(s.c_str(), t.c_str());
+                if (rr < 0) { ok = false; logf("cat merge: move fail %s -> %s rc=%d", s.c_str(), t.c_str(), rr); }
+            } else if (kid.second && hit->second) {
+                // Same game folder on both sides: only now look inside.
+                if (!mergeDirPreferDest(s, t)) ok = false;
+                int rr = kfeIoRmdir(s.c_str());
+                if (rr < 0) { ok = false; logf("cat merge: rmdir fail %s rc=%d", s.c_str(), rr); }
+            } else if (!kid.second) {
+                logf("cat merge: conflict keep dst %s", t.c_str());
+                int rr = kfeIoRemove(s.c_str());
+                if (rr < 0) { ok = false; logf("cat merge: remove src fail %s rc=%d", s.c_str(), rr); }
             } else {
-                if (pathExists(t)) {
-                    logf("cat merge: conflict keep dst %s", t.c_str());
-                    int rr = sceIoRemove(s.c_str());
-                    if (rr < 0) { ok = false; logf("cat merge: remove src fail %s rc=%d", s.c_str(), rr); }
-                } else {
-                    int rr = sceIoRename(s.c_str(), t.c_str());
-                    if (rr < 0) { ok = false; logf("cat merge: rename file fail %s -> %s rc=%d", s.c_str(), t.c_str(), rr); }
-                }
+                ok = false;
+                logf("cat merge: dir/file clash, left in place %s", s.c_str());
             }
-
-            memset(&ent, 0, sizeof(ent));
             sceKernelDelayThread(0);
         }
-        kfeIoCloseDir(d);
 
         return ok;
     }
@@ -602,66 +614,20 @@ private:
         logf("cat merge: %s -> %s", src.c_str(), dst.c_str());
         bool ok = mergeDirPreferDest(src, dst);
         if (ok) updateHiddenAppPathsForFolderRename(absRoot, from, to);
-        int rr = sceIoRmdir(src.c_str());
+        int rr = kfeIoRmdir(src.c_str());
         if (rr < 0) { ok = false; logf("cat merge: source not empty %s rc=%d", src.c_str(), rr); }
         logClose();
 
         return ok;
     }
 
-    static void normalizeCategoryFolderForBase(const std::string& absRoot,
-                                               const std::vector<std::string>& subs,
-                                               const std::string& base,
-                                               const std::string& want,
-                                               bool stripNumbers) {
-        std::vector<std::string> matches;
-        matches.reserve(subs.size());
-        for (const auto &sub : subs) {
-            if (strcasecmp(stripCategoryPrefixes(sub, stripNumbers).c_str(), base.c_str()) != 0) continue;
-            std::string subAbs = joinDirFile(absRoot, sub.c_str());
-            if (!findEbootCaseInsensitive(subAbs).empty()) continue; // skip real games
-            matches.push_back(sub);
-        }
-        if (matches.empty()) return;
-
-        auto isWant = [&](const std::string& s){ return !strcasecmp(s.c_str(), want.c_str()); };
-        bool haveWant = false;
-        for (const auto& m : matches) {
-            if (isWant(m)) { haveWant = true; break; }
-        }
-
-        std::string wantAbs = joinDirFile(absRoot, want.c_str());
-        if (!haveWant) {
-            if (dirExists(wantAbs)) {
-                haveWant = true;
-            } else {
-                std::string primary = matches[0];
-                renameIfExists(absRoot, primary, want);
-                if (dirExists(wantAbs)) haveWant = true;
-                else {
-                    logInit();
-                    logf("cat normalize: rename fail %s -> %s",
-                         joinDirFile(absRoot, primary.c_str()).c_str(), wantAbs.c_str());
-                    logClose();
-                }
-            }
-        }
-
-        if (haveWant) {
-            for (const auto& m : matches) {
-                if (isWant(m)) continue;
-                mergeCategoryFolders(absRoot, m, want);
-            }
-        }
-    }
-
     // Rename “from”→“to” if it exists and differs (ignores case-only changes)
     static void renameIfExists(const std::string& root, const std::string& from, const std::string& to){
         if (!strcasecmp(from.c_str(), to.c_str())) return;
         std::string a = joinDirFile(root, from.c_str());
         std::string b = joinDirFile(root, to.c_str());
         if (dirExists(a)) {
-            int rc = sceIoRename(a.c_str(), b.c_str());
+            int rc = kfeIoRename(a.c_str(), b.c_str());
             if (rc >= 0) {
                 updateHiddenAppPathsForFolderRename(root, from, to);
             } else {
@@ -672,6 +638,55 @@ private:
         }
     }
 
+    // Category rename planning lives in kfe_cat_plan.h; this side does the
+    // listing and applies the steps.
+    static void listCategoryRoots(const std::string& dev, const char* const* rels, size_t nRels,
+                                  const std::unordered_set<std::string>& foldedBases, bool stripNumbers,
+                                  std::vector<KfeCatRootListing>& out) {
+        KfeDirCacheScope dirCache;   // EBOOT probes share one listing per folder
+        for (size_t r = 0; r < nRels; ++r) {
+            KfeCatRootListing L;
+            L.absRoot = dev + std::string(rels[r]);
+            listSubdirs(L.absRoot, L.subs);
+            L.bases.assign(L.subs.size(), std::string());
+            for (size_t i = 0; i < L.subs.size(); ++i) {
+                // Only candidates need the EBOOT probe.
+                std::string base = kfeFoldCase(stripCategoryPrefixes(L.subs[i], stripNumbers).c_str());
+                if (!foldedBases.count(base)) continue;
+                if (!kfeIsGameFolderIn(L.absRoot, L.subs[i])) L.bases[i].swap(base);
+            }
+            out.push_back(std::move(L));
+        }
+    }
+
+    static void logCategoryPlan(const std::string& dev, const std::vector<KfeCatPlanStep>& plan) {
+        logInit();
+        logf("cat plan %s: %u step(s)", dev.c_str(), (unsigned)plan.size());
+        for (const auto& st : plan)
+            logf("  %s %s%s -> %s", st.kind == KfeCatPlanStep::Rename ? "REN" : "MRG",
+                 st.absRoot.c_str(), st.from.c_str(), st.to.c_str());
+        logClose();
+    }
+
+    // Brings every category folder variant on dev to its wanted name.
+    static void enforceCategoryNames(const std::string& dev, const char* const* rels, size_t nRels,
+                                     const KfeCatWantList& wants, bool stripNumbers) {
+        std::unordered_set<std::string> foldedBases;
+        for (const auto& w : wants) foldedBases.insert(kfeFoldCase(w.first.c_str()));
+
+        std::vector<KfeCatRootListing> listings;
+        listCategoryRoots(dev, rels, nRels, foldedBases, stripNumbers, listings);
+        std::vector<KfeCatPlanStep> plan;
+        kfePlanCategoryRenames(listings, wants, plan);
+        if (plan.empty()) return;
+        logCategoryPlan(dev, plan);
+
+        for (const auto& st : plan) {
+            if (st.kind == KfeCatPlanStep::Rename) renameIfExists(st.absRoot, st.from, st.to);
+            else                                mergeCategoryFolders(st.absRoot, st.from, st.to);
+        }
+    }
+
     // Enforce naming/numbering for category folders on a device, obeying rules:
     // • Leave folders that already have an XX number alone, UNLESS the number > total categories (then reassign).
     // • Never produce duplicate XX across different categories; if duplicates exist, keep the first by base (A→Z).
@@ -680,6 +695,8 @@ private:
     // • Skip game folders (subdirs that contain an EBOOT.PBP) and ISO/VIDEO.
     // • Skip game folders (subdirs that contain an EBOOT.PBP) and ISO/VIDEO.
     static void enforceCategorySchemeForDevice(const std::string& dev, bool forceStripNumbers = false){
+        KfeCatTopoScope catTopo;
+        GclFilterBatch filterBatch;   // hidden-app path fixups from every rename land in one write
         const char* isoRoots[]  = {"ISO/"};                // drop ISO/PSP/ as a root
         const char* gameRoots[] = {"PSP/GAME/","PSP/GAME/PSX/","PSP/GAME/Utility/","PSP/GAME150/"};
 
@@ -704,8 +721,7 @@ private:
             for (auto &sub : subs){
                 if (isBlacklistedCategoryFolder(rootLabel, sub, absRoot, forceStripNumbers)) continue;
                 // Skip real game folders
-                std::string subAbs = joinDirFile(absRoot, sub.c_str());
-                if (!findEbootCaseInsensitive(subAbs).empty()) continue;
+                if (kfeIsGameFolderIn(absRoot, sub)) continue;
 
                 std::string base = stripCategoryPrefixes(sub, stripNumbers);
                 baseSet.insert(base);
@@ -763,17 +779,12 @@ private:
         }
 
         // 5) For each root, normalize any present variants → desired formatted name
-        for (auto &rp : roots){
-            const std::string& absRoot = rp.first;
-            std::vector<std::string> subs;
-            listSubdirs(absRoot, subs);
-
-            for (const auto& base : baseList){
-                const int idx = assigned[base];
-                const std::string want = formatCategoryNameFromBase(base, idx);
-                normalizeCategoryFolderForBase(absRoot, subs, base, want, stripNumbers);
-            }
-        }
+        KfeCatWantList wants;
+        for (const auto& base : baseList) wants.emplace_back(base, formatCategoryNameFromBase(base, assigned[base]));
+        std::vector<const char*> rels;
+        for (auto r : isoRoots)  rels.push_back(r);
+        for (auto r : gameRoots) rels.push_back(r);
+        enforceCategoryNames(dev, rels.data(), rels.size(), wants, stripNumbers);
     }
 
 
@@ -913,6 +924,34 @@ private:
     unsigned long long upHoldStartUS   = 0, upLastRepeatUS   = 0;
     unsigned long long downHoldStartUS = 0, downLastRepeatUS = 0;
 
+    // Last progress repaint (renderProgressFrame throttle)
+    unsigned long long progressPaintUS = 0;
+    // Last progress frame was swapped without a vblank wait (waitProgressSwapLatched)
+    bool progressSwapPending = false;
+
+    // Idle frame skipping (see frameNeedsPaint). frameDirty forces the next
+    // main-loop paint; set where the drawn state changes without input or a
+    // fingerprinted field changing: op completion, toasts (drawMessage) and
+    // restoreScan/clearUI.
+    bool frameDirty = true;
+    bool frameAnimating = false;      // set by draw code that moves on its own
+    unsigned long long frameWakeUS = 0;   // repaint no later than this (0 = no timer)
+    unsigned long long framePaintUS = 0;
+    unsigned framePaintGen = 0;
+    unsigned framePaintSig = 0;
+    unsigned framePaintPad = 0;
+
+    // Row label layout (see rowTextLayout); cleared with the list.
+    struct RowTextLayout {
+        float scale = 0.0f, maxW = 0.0f;
+        float width = 0.0f;               // full label
+        std::string clipped;              // what fits maxW at rest
+        intraFont* font = nullptr;        // picked for clipped
+        std::vector<float> underscoreX;   // x of each '_' in clipped
+        float underscoreW = 0.0f;
+    };
+    std::unordered_map<std::string, RowTextLayout> rowTextCache;
+
     // Cache of entries that have no embedded icon; use placeholder and don't retry.
     std::unordered_set<std::string> noIconPaths;
     // Short grace period after self move/rename to avoid memoizing transient icon lookup failures.
@@ -963,6 +1002,9 @@ private:
                                 popPanelW, popPanelH);
         renderOneFrame();
 
+        KfeCatTopoScope catTopo;   // shared by both devices' rename plans and the mtime sort
+        GclFilterBatch filterBatch;
+
         // 2) Make a base->index map according to the on-screen order
         std::map<std::string,int> assigned;
         if (gclCfg.catsort) {
@@ -982,21 +1024,14 @@ private:
         //    Only touch category folders inside ISO/ and PSP/GAME*/ roots. Never touch root-level PSP/.
         const char* isoRoots[]  = {"ISO/"};
         const char* gameRoots[] = {"PSP/GAME/","PSP/GAME150/","PSP/GAME/PSX/","PSP/GAME/Utility/"};
+        KfeCatWantList wants(baseToWant.begin(), baseToWant.end());
+        std::vector<const char*> rels;
+        for (const char* r : isoRoots)  rels.push_back(r);
+        for (const char* r : gameRoots) rels.push_back(r);
         auto doDevice = [&](const std::string& dev){
             if (dev.empty() || dev[3] != ':') return;
-            for (auto& kv : baseToWant) {
-                const std::string& base = kv.first;
-                const std::string& want = kv.second;
-
-                // For each root, find any variant for this base and rename to the wanted name
-                auto renameIn = [&](const char* r){
-                    std::string abs = dev + std::string(r);
-                    std::vector<std::string> subs; listSubdirs(abs, subs);
-                    normalizeCategoryFolderForBase(abs, subs, base, want, gclCfg.catsort);
-                };
-                for (const char* r : isoRoots)  renameIn(r);
-                for (const char* r : gameRoots) renameIn(r);
-            }
+            // One listing per root; all bases planned and renamed together.
+            enforceCategoryNames(dev, rels.data(), rels.size(), wants, gclCfg.catsort != 0);
         };
 
         // Persist renames for the *current* device.
@@ -1195,6 +1230,8 @@ private:
     std::vector<GameItem::Kind> opSrcKinds;
     int         opSrcCount = 0;
     uint64_t    opSrcTotalBytes = 0;
+    bool        opVerify = false;          // □ on the confirm box: CRC-check every copied file
+    bool        opVerifyKeyHeld = false;
 
     // Destination selections
     std::string opDestDevice;     // "ms0:/" or "ef0:/"
@@ -1242,6 +1279,17 @@ private:
     void markAllDevicesDirty() {
         for (auto &kv : deviceCache) kv.second.dirty = true;
         for (const auto &r : roots) markDeviceDirty(r);
+        DevPrefetchReset(false);   // prefetched items predate whatever made us dirty
+    }
+
+    // PSP Go: let the background worker warm every root whose cache line is stale,
+    // so picking the other device only has to enumerate folders.
+    void kickDevicePrefetch() {
+        if (roots.size() < 2 || gUsbActive) return;
+        for (const auto &r : roots) {
+            auto it = deviceCache.find(r);
+            if (it == deviceCache.end() || it->second.dirty) DevPrefetchKick(r);
+        }
     }
 
     void setCategorySortMode(bool enable, bool saveOnExit = false) {
@@ -1302,6 +1350,7 @@ private:
         opSrcKinds.clear();
         opSrcCount = 0;
         opSrcTotalBytes = 0;
+        opVerify = false;
         opDestDevice.clear();
         opDestCategory.clear();
         moving = false;
@@ -1398,6 +1447,7 @@ private:
         flatAll        = in.flatAll;
         categoryNames  = in.categoryNames;
         hasCategories  = in.hasCategories;
+        frameDirty = true;
     }
 
     // Fetch prefix like "ms0:/" from any path or device string you use elsewhere
@@ -1619,6 +1669,37 @@ private:
     }
 
 
+    // Same answer as countGamesInCategory(), served from the device snapshot.
+    // The cache-patch helpers keep snapshot items exact across add/delete/
+    // rename/move/copy, so the disk is only walked when the line is dirty
+    // or the category isn't in it (e.g. blacklisted).
+    int categoryGameCount(const std::string& dev, const std::string& cat) const {
+        auto it = deviceCache.find(rootPrefix(dev));
+        if (it == deviceCache.end() || it->second.dirty) return countGamesInCategory(dev, cat);
+        auto ct = it->second.snap.categories.find(cat);
+        if (ct == it->second.snap.categories.end()) return countGamesInCategory(dev, cat);
+
+        const std::string devRoot = rootPrefix(dev);
+        const std::string isoDir   = devRoot + "ISO/" + cat + "/";
+        const std::string gameDir  = devRoot + "PSP/GAME/" + cat + "/";
+        const std::string game150  = devRoot + "PSP/GAME150/" + cat + "/";
+        auto directChildOf = [](const std::string& path, const std::string& dir){
+            return path.size() > dir.size() &&
+                   !strncasecmp(path.c_str(), dir.c_str(), dir.size()) &&
+                   path.find('/', dir.size()) == std::string::npos;
+        };
+
+        int count = 0;
+        for (const auto& gi : ct->second) {
+            if (gi.kind == GameItem::ISO_FILE) {
+                if (directChildOf(gi.path, isoDir)) count++;
+            } else if (directChildOf(gi.path, gameDir) || directChildOf(gi.path, game150)) {
+                count++;   // PSX/ and Utility/ aren't counted, matching the disk walk
+            }
+        }
+        return count;
+    }
+
     static void replaceCatSegmentInPath(const std::string& oldCat,
                                         const std::string& newCat,
                                         std::string& pathInOut) {
@@ -2044,10 +2125,10 @@ private:
         return intraFontMeasureText(f, s);
     }
     void drawTextStyled(float x, float y, const char* s, float size, unsigned col, unsigned shadow,
-                        int align, bool bold) {
+                        int align, bool bold, intraFont* f = nullptr) {
         if (!s) return;
         if (font) {
-            intraFont* f = pickFontForText(s);
+            if (!f) f = pickFontForText(s);
             if (f) {
                 intraFontActivate(f);
                 intraFontSetStyle(f, size, col, shadow, 0.0f, align);
@@ -2121,6 +2202,56 @@ private:
         if (maxChars <= 3) return s.substr(0, maxChars);
         return s.substr(0, maxChars - 3) + "...";
     }
+    // Longest prefix of s (after skipping offsetPx) that fits maxW.
+    std::string clipTextToWidth(const std::string& s, float maxW, float offsetPx, float scale) {
+        if (s.empty() || maxW <= 0.0f) return std::string();
+        float skip = (offsetPx > 0.0f) ? offsetPx : 0.0f;
+        float used = 0.0f;
+        std::string out;
+        out.reserve(s.size());
+        size_t ci = 0;
+        while (ci < s.size()) {
+            unsigned char lead = (unsigned char)s[ci];
+            size_t charLen = (lead < 0x80) ? 1 : ((lead & 0xE0) == 0xC0) ? 2 : ((lead & 0xF0) == 0xE0) ? 3 : ((lead & 0xF8) == 0xF0) ? 4 : 1;
+            if (ci + charLen > s.size()) break;
+            std::string ch = s.substr(ci, charLen);
+            float cw = measureTextWidth(scale, ch.c_str());
+            if (skip > 0.0f) {
+                if (skip >= cw) { skip -= cw; ci += charLen; continue; }
+                skip = 0.0f;
+                ci += charLen;
+                continue;
+            }
+            if (used + cw > maxW) break;
+            out += ch;
+            used += cw;
+            ci += charLen;
+        }
+        return out;
+    }
+
+    // List rows at rest: font, width and clipped text only change with the
+    // label, so they're computed once instead of per glyph every frame.
+    const RowTextLayout& rowTextLayout(const std::string& s, float scale, float maxW) {
+        auto it = rowTextCache.find(s);
+        if (it != rowTextCache.end() && it->second.scale == scale && it->second.maxW == maxW) return it->second;
+        if (it == rowTextCache.end() && rowTextCache.size() >= 512) rowTextCache.clear();
+        RowTextLayout& L = rowTextCache[s];
+        L.scale = scale;
+        L.maxW = maxW;
+        L.width = measureTextWidth(scale, s.c_str());
+        L.clipped = (maxW > 0.0f) ? clipTextToWidth(s, maxW, 0.0f, scale) : s;
+        L.font = font ? pickFontForText(L.clipped.c_str()) : nullptr;
+        L.underscoreX.clear();
+        if (L.clipped.find('_') != std::string::npos) {
+            L.underscoreW = measureTextWidth(scale, "_");
+            for (size_t ci = 0; ci < L.clipped.size(); ++ci) {
+                if (L.clipped[ci] == '_')
+                    L.underscoreX.push_back(measureTextWidth(scale, L.clipped.substr(0, ci).c_str()));
+            }
+        }
+        return L;
+    }
     std::string currentCategoryHeaderLabel() const {
         if (view == View_CategoryContents) {
             if (!currentCategory.empty()) return currentCategory;
@@ -2817,6 +2948,11 @@ private:
         drawRect((int)animX, (int)(animY - 1.0f), (int)animW, (int)(animH + 1.0f), COLOR_BANNER);
 
         advanceHomeAnimationFrame();
+        if (gHomeAnimIndex >= 0 && !gHomeAnimPaused) {
+            // Wake for the next animation frame rather than painting every vblank.
+            if (!gHomeAnimNextUs) frameAnimating = true;
+            else if (!frameWakeUS || gHomeAnimNextUs < frameWakeUS) frameWakeUS = gHomeAnimNextUs;
+        }
         Texture* animTex = getCurrentHomeAnimTexture();
         if (animTex && animTex->data && animTex->width > 0 && animTex->height > 0) {
             const float pad = 8.0f;
@@ -3090,32 +3226,6 @@ private:
             catScrollIndex = selectedIndex;
             catScrollStartUs = nowUs;
         }
-        auto clipTextToWidth = [&](const std::string& s, float maxW, float offsetPx, float scale)->std::string {
-            if (s.empty() || maxW <= 0.0f) return std::string();
-            float skip = (offsetPx > 0.0f) ? offsetPx : 0.0f;
-            float used = 0.0f;
-            std::string out;
-            out.reserve(s.size());
-            size_t ci = 0;
-            while (ci < s.size()) {
-                unsigned char lead = (unsigned char)s[ci];
-                size_t charLen = (lead < 0x80) ? 1 : ((lead & 0xE0) == 0xC0) ? 2 : ((lead & 0xF0) == 0xE0) ? 3 : ((lead & 0xF8) == 0xF0) ? 4 : 1;
-                if (ci + charLen > s.size()) break;
-                std::string ch = s.substr(ci, charLen);
-                float cw = measureTextWidth(scale, ch.c_str());
-                if (skip > 0.0f) {
-                    if (skip >= cw) { skip -= cw; ci += charLen; continue; }
-                    skip = 0.0f;
-                    ci += charLen;
-                    continue;
-                }
-                if (used + cw > maxW) break;
-                out += ch;
-                used += cw;
-                ci += charLen;
-            }
-            return out;
-        };
 
         auto drawRow = [&](int i, float centerY, bool showCount, bool showAppsLabel) {
             const char* name = entries[i].d_name;
@@ -3193,41 +3303,49 @@ private:
                 }
             }
 
+            const RowTextLayout& lay = rowTextLayout(name, scale, textAvailW);
             float textOffsetX = 0.0f;
             float textOverflow = 0.0f;
             if (textAvailW > 0.0f) {
-                const float textW = measureTextWidth(scale, name);
-                textOverflow = textW - textAvailW;
+                textOverflow = lay.width - textAvailW;
             }
             if (sel && textOverflow > 2.0f) {
                 const float speed = 120.0f; // px/sec
                 const double elapsed = (double)(nowUs - catScrollStartUs) / 1000000.0;
                 textOffsetX = (float)(elapsed * speed);
                 if (textOffsetX > textOverflow) textOffsetX = textOverflow;
+                else frameAnimating = true;
             }
 
-            std::string drawLabel = name;
-            if (textAvailW > 0.0f) {
-                const float clipOffset = (textOffsetX > 0.0f) ? textOffsetX : 0.0f;
-                drawLabel = clipTextToWidth(drawLabel, textAvailW, clipOffset, scale);
-            }
-
-            drawTextStyled(textLeftX, baseline, drawLabel.c_str(),
-                           scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false);
-            if (drawLabel.find('_') != std::string::npos) {
-                const float underscoreW = measureTextWidth(scale, "_");
-                const float underlineY = baseline + 2.0f;
-                std::string prefix;
-                prefix.reserve(drawLabel.size());
-                for (size_t ci = 0; ci < drawLabel.size(); ++ci) {
-                    if (drawLabel[ci] == '_') {
-                        float prefixW = measureTextWidth(scale, prefix.c_str());
-                        float ux = textLeftX + prefixW;
-                        int lineW = (int)(underscoreW + 1.0f);
-                        if (lineW < 1) lineW = 1;
-                        drawRect((int)(ux), (int)(underlineY - 1.0f), lineW, 1, textCol);
+            if (textOffsetX <= 0.0f) {
+                drawTextStyled(textLeftX, baseline, lay.clipped.c_str(),
+                               scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false, lay.font);
+                for (float prefixW : lay.underscoreX) {
+                    int lineW = (int)(lay.underscoreW + 1.0f);
+                    if (lineW < 1) lineW = 1;
+                    drawRect((int)(textLeftX + prefixW), (int)(baseline + 2.0f - 1.0f), lineW, 1, textCol);
+                }
+            } else {
+                // Scrolling marquee (selected row only): clip at the live offset.
+                const std::string drawLabel = clipTextToWidth(name, textAvailW, textOffsetX, scale);
+
+                drawTextStyled(textLeftX, baseline, drawLabel.c_str(),
+                               scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false);
+                if (drawLabel.find('_') != std::string::npos) {
+                    const float underscoreW = measureTextWidth(scale, "_");
+                    const float underlineY = baseline + 2.0f;
+                    std::string prefix;
+                    prefix.reserve(drawLabel.size());
+                    for (size_t ci = 0; ci < drawLabel.size(); ++ci) {
+                        if (drawLabel[ci] == '_') {
+                            float prefixW = measureTextWidth(scale, prefix.c_str());
+                            float ux = textLeftX + prefixW;
+                            int lineW = (int)(underscoreW + 1.0f);
+                            if (lineW < 1) lineW = 1;
+                            drawRect((int)(ux), (int)(underlineY - 1.0f), lineW, 1, textCol);
+                        }
+                        prefix.push_back(drawLabel[ci]);
                     }
-                    prefix.push_back(drawLabel[ci]);
                 }
             }
 
@@ -3518,32 +3636,6 @@ private:
             gameScrollStartUs = nowUs;
         }
 
-        auto clipTextToWidth = [&](const std::string& s, float maxW, float offsetPx)->std::string {
-            if (s.empty() || maxW <= 0.0f) return std::string();
-            float skip = (offsetPx > 0.0f) ? offsetPx : 0.0f;
-            float used = 0.0f;
-            std::string out;
-            out.reserve(s.size());
-            size_t ci = 0;
-            while (ci < s.size()) {
-                unsigned char lead = (unsigned char)s[ci];
-                size_t charLen = (lead < 0x80) ? 1 : ((lead & 0xE0) == 0xC0) ? 2 : ((lead & 0xF0) == 0xE0) ? 3 : ((lead & 0xF8) == 0xF0) ? 4 : 1;
-                if (ci + charLen > s.size()) break;
-                std::string ch = s.substr(ci, charLen);
-                float cw = measureTextWidth(scale, ch.c_str());
-                if (skip > 0.0f) {
-                    if (skip >= cw) { skip -= cw; ci += charLen; continue; }
-                    skip = 0.0f;
-                    ci += charLen;
-                    continue;
-                }
-                if (used + cw > maxW) break;
-                out += ch;
-                used += cw;
-                ci += charLen;
-            }
-            return out;
-        };
 
         for(int i = startRow; i < endRow; i++){
             bool sel  = (i == selectedIndex);
@@ -3650,28 +3742,30 @@ private:
                 }
             }
 
-            std::string label = entries[i].d_name;
-            std::string drawLabel = label;
+            const std::string label = entries[i].d_name;
+            const RowTextLayout& lay = rowTextLayout(label, scale, textAvailW);
             float textOffsetX = 0.0f;
             float textOverflow = 0.0f;
             if (textAvailW > 0.0f) {
-                const float textW = measureTextWidth(scale, label.c_str());
-                textOverflow = textW - textAvailW;
+                textOverflow = lay.width - textAvailW;
             }
             if (sel && textOverflow > 2.0f) {
                 const float speed = 120.0f; // px/sec
                 const double elapsed = (double)(nowUs - gameScrollStartUs) / 1000000.0;
                 textOffsetX = (float)(elapsed * speed);
                 if (textOffsetX > textOverflow) textOffsetX = textOverflow;
+                else frameAnimating = true;
             }
-            if (textAvailW > 0.0f) {
-                const float clipOffset = (textOffsetX > 0.0f) ? textOffsetX : 0.0f;
-                drawLabel = clipTextToWidth(label, textAvailW, clipOffset);
+            if (textOffsetX <= 0.0f) {
+                drawTextStyled(textLeftX, baseline, lay.clipped.c_str(),
+                               scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false, lay.font);
+            } else {
+                // Scrolling marquee (selected row only): clip at the live offset.
+                const std::string drawLabel = clipTextToWidth(label, textAvailW, textOffsetX, scale);
+                drawTextStyled(textLeftX, baseline, drawLabel.c_str(),
+                               scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false);
             }
 
-            drawTextStyled(textLeftX, baseline, drawLabel.c_str(),
-                           scale, textCol, shadowCol, INTRAFONT_ALIGN_LEFT, false);
-
 
             if ((view==View_AllFlat || view==View_CategoryContents) && showDebugTimes && !isDir) {
                 if (i >= 0 && i < (int)workingList.size()) {
@@ -3953,6 +4047,7 @@ private:
     }
 
     void drawMessage(const char* m,unsigned c) {
+        frameDirty = true;   // the toast is drawn over the last frame; repaint after it
         int x=80,y=SCREEN_HEIGHT/2-20;
         drawRect(x-10,y-5,SCREEN_WIDTH-2*x+20,30,0xFF404040);
         drawRect(x-11,y-6,SCREEN_WIDTH-2*x+22,32,COLOR_WHITE);
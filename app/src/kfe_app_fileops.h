@@ -36,10 +36,34 @@ static bool kfeWaitForPathPresence(const std::string& path) {
     return pathExists(path);
 }
 
-static void kfeCollectAllSourceFiles(const std::string& srcDir,
-                                     const std::string& dstDir,
-                                     std::vector<KfeCopyPathPair>& out,
-                                     bool& scanOk) {
+// --- small-file fast path for folder copies ---
+// Files up to this size are copied with one read and one write straight from
+// the dirent size: no stat, no parent checks (the walker already made the
+// directory), throttled progress. Anything unexpected falls back to copyFile().
+static const SceOff KFE_SMALL_FILE_MAX = 64 * 1024;
+
+static bool kfeCopySmallFile(const std::string& src, const std::string& dst, SceOff size,
+                             uint8_t* buf, size_t bufSize, uint32_t* outCrc) {
+    SceUID in = sceIoOpen(src.c_str(), PSP_O_RDONLY, 0);
+    if (in < 0) return false;
+    int rd = sceIoRead(in, buf, (SceSize)bufSize);
+    sceIoClose(in);
+    if (rd < 0 || (SceOff)rd != size) return false;   // changed under us -> slow path
+    if (outCrc) *outCrc = (uint32_t)crc32(crc32(0L, Z_NULL, 0), buf, (uInt)rd);
+
+    SceUID out = sceIoOpen(dst.c_str(), PSP_O_WRONLY | PSP_O_CREAT | PSP_O_TRUNC, 0666);
+    kfeDirCacheInvalidate(dst);
+    if (out < 0) return false;
+    int w = rd ? sceIoWrite(out, buf, rd) : 0;
+    sceIoClose(out);
+    if (w != rd) { kfeIoRemove(dst); return false; }
+    return true;
+}
+
+static void kfeCollectAllSourceFilesWalk(const std::string& srcDir,
+                                         const std::string& dstDir,
+                                         std::vector<KfeCopyPathPair>& out,
+                                         bool& scanOk) {
     SceUID d = kfeIoOpenDir(srcDir.c_str());
     if (d < 0) { scanOk = false; return; }
 
@@ -55,7 +79,7 @@ static void kfeCollectAllSourceFiles(const std::string& srcDir,
         }
         std::string s = joinDirFile(srcDir, ent.d_name);
         std::string t = joinDirFile(dstDir, ent.d_name);
-        if (FIO_S_ISDIR(ent.d_stat.st_mode)) kfeCollectAllSourceFiles(s, t, out, scanOk);
+        if (FIO_S_ISDIR(ent.d_stat.st_mode)) kfeCollectAllSourceFilesWalk(s, t, out, scanOk);
         else out.push_back({s, t});
         memset(&ent, 0, sizeof(ent));
         sceKernelDelayThread(0);
@@ -63,6 +87,103 @@ static void kfeCollectAllSourceFiles(const std::string& srcDir,
     kfeIoCloseDir(d);
 }
 
+// True if any '/'-separated component of rel is Mac metadata junk.
+static bool kfeRelPathHasMacJunk(const char* rel) {
+    char comp[256];
+    while (*rel) {
+        size_t n = 0;
+        while (rel[n] && rel[n] != '/') ++n;
+        const size_t m = n < sizeof(comp) - 1 ? n : sizeof(comp) - 1;
+        memcpy(comp, rel, m); comp[m] = '\0';
+        if (kfeIsMacJunkName(comp)) return true;
+        rel += n; if (*rel == '/') ++rel;
+    }
+    return false;
+}
+
+// Every file below srcDir paired with its target below dstDir, in on-disk order.
+// One pspIoWalkTree call when the driver has it; otherwise the user-mode walk.
+static void kfeCollectAllSourceFiles(const std::string& srcDir,
+                                     const std::string& dstDir,
+                                     std::vector<KfeCopyPathPair>& out,
+                                     bool& scanOk) {
+    std::vector<char> manifest;
+    PspIoTreeStats st;
+    if (!kfeWalkTree(srcDir, st, &manifest)) {
+        kfeCollectAllSourceFilesWalk(srcDir, dstDir, out, scanOk);
+        return;
+    }
+    out.reserve(out.size() + st.files);
+    for (size_t i = 0; i < manifest.size(); ) {
+        const char  kind = manifest[i];
+        const char* rel  = &manifest[i + 1];
+        i += strlen(rel) + 2;
+        if (kind != 'F' || kfeRelPathHasMacJunk(rel)) continue;
+        out.push_back({joinDirFile(srcDir, rel), joinDirFile(dstDir, rel)});
+    }
+}
+
+// --- delete plan ---
+// Packed "<kind><rel path>\0" records in the same order pspIoWalkTree emits
+// them: a folder's files first, each subfolder after its contents. Walking the
+// list front to back removes files directory by directory and rmdirs deepest
+// first, without reading a directory while deleting from it.
+static void kfeManifestAppend(std::vector<char>& out, char kind, const std::string& rel) {
+    out.push_back(kind);
+    out.insert(out.end(), rel.begin(), rel.end());
+    out.push_back('\0');
+}
+
+static void kfeDeleteManifestWalk(const std::string& dir, const std::string& rel,
+                                  std::vector<char>& out, PspIoTreeStats& st, bool& scanOk) {
+    std::vector<std::string> files, dirs;
+    {
+        KfeDirReader rd(dir.c_str());
+        if (!rd.ok()) { scanOk = false; return; }
+        SceIoDirent ent;
+        while (rd.next(ent)) {
+            if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) continue;
+            if (FIO_S_ISDIR(ent.d_stat.st_mode)) { dirs.push_back(ent.d_name); continue; }
+            files.push_back(ent.d_name);
+            st.files++; st.bytes += (u64)ent.d_stat.st_size;
+        }
+    }
+    for (const auto& f : files) kfeManifestAppend(out, 'F', rel.empty() ? f : rel + "/" + f);
+    for (const auto& d : dirs) {
+        const std::string sub = rel.empty() ? d : rel + "/" + d;
+        kfeDeleteManifestWalk(joinDirFile(dir, d.c_str()), sub, out, st, scanOk);
+        kfeManifestAppend(out, 'D', sub);
+        st.dirs++;
+    }
+}
+
+// One pspIoWalkTree call when the driver has it; otherwise the user-mode walk.
+// st receives the file/byte totals either way.
+static bool kfeBuildDeleteManifest(const std::string& dir, std::vector<char>& manifest, PspIoTreeStats& st) {
+    if (kfeWalkTree(dir, st, &manifest)) return true;
+    manifest.clear();
+    memset(&st, 0, sizeof(st));
+    bool scanOk = true;
+    kfeDeleteManifestWalk(dir, std::string(), manifest, st, scanOk);
+    return scanOk;
+}
+
+// Removals that also update the cached free space.
+static bool kfeRemoveFileAccounted(const std::string& path) {
+    SceIoStat st{};
+    const bool known = pathExists(path, &st);
+    if (kfeIoRemove(path) < 0) return false;
+    if (known) FreeSpaceAccount(path, (int64_t)st.st_size);
+    return true;
+}
+static bool kfeRemoveDirAccounted(const std::string& dir) {
+    PspIoTreeStats st;
+    const bool known = kfeWalkTree(dir, st, nullptr);
+    if (!KfeFileOps::removeDirRecursive(dir)) return false;
+    if (known) FreeSpaceAccount(dir, (int64_t)st.bytes, st.files);
+    return true;
+}
+
 static void kfeCollectMissingDestFiles(const std::string& srcDir,
                                        const std::string& dstDir,
                                        std::vector<KfeCopyPathPair>& out,
@@ -101,33 +222,58 @@ static void kfeCollectMissingDestFiles(const std::string& srcDir,
     kfeIoCloseDir(d);
 }
 
+// Rename path into its volume's trash folder. False -> caller deletes in place.
+static bool kfeTrashMove(const std::string& path) {
+    const std::string trash = kfeTrashDirFor(path);
+    if (trash.empty()) return false;
+    SceIoStat st{};
+    if (sceIoGetstat(trash.c_str(), &st) < 0) {
+        if (sceIoMkdir(trash.c_str(), 0777) < 0) return false;
+        kfeDirCacheInvalidate(trash);
+    }
+
+    char tag[16];
+    snprintf(tag, sizeof(tag), "%08X_", (unsigned)(nowUS() + gKfeTrash.seq++));
+    std::string src = path;
+    while (src.size() > 5 && src.back() == '/') src.pop_back();
+    const std::string dst = trash + "/" + tag + basenameOf(src);
+    if (KfeFileOps::kfeFastMoveDevctl(src.c_str(), dst.c_str()) < 0) return false;
+    if (pathExists(src)) return false;   // devctl claimed success but nothing moved
+    return true;
+}
+
 // Remove every destination entry whose name matches leaf case-insensitively.
 // This prevents BOOT/boot duplicate-name collisions before copy/move.
 static void kfeRemoveCaseCollisionsInDir(const std::string& dir, const std::string& leaf) {
     if (dir.empty() || leaf.empty()) return;
-    SceUID d = kfeIoOpenDir(dir.c_str());
-    if (d < 0) return;
-
     std::vector<std::string> matches;
-    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-    while (kfeIoReadDir(d, &ent) > 0) {
-        trimTrailingSpaces(ent.d_name);
-        if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) {
+    if (const KfeDirListing* L = kfeDirCacheListing(dir)) {
+        auto range = L->byFolded.equal_range(kfeFoldCase(leaf.c_str()));
+        for (auto it = range.first; it != range.second; ++it)
+            matches.push_back(joinDirFile(dir, L->entries[it->second].name.c_str()));
+    } else {
+        SceUID d = kfeIoOpenDir(dir.c_str());
+        if (d < 0) return;
+        SceIoDirent ent; memset(&ent, 0, sizeof(ent));
+        while (kfeIoReadDir(d, &ent) > 0) {
+            trimTrailingSpaces(ent.d_name);
+            if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) {
+                memset(&ent, 0, sizeof(ent));
+                continue;
+            }
+            if (!strcasecmp(ent.d_name, leaf.c_str())) {
+                matches.push_back(joinDirFile(dir, ent.d_name));
+            }
             memset(&ent, 0, sizeof(ent));
-            continue;
         }
-        if (!strcasecmp(ent.d_name, leaf.c_str())) {
-            matches.push_back(joinDirFile(dir, ent.d_name));
-        }
-        memset(&ent, 0, sizeof(ent));
+        kfeIoCloseDir(d);
     }
-    kfeIoCloseDir(d);
 
     for (size_t i = 0; i < matches.size(); ++i) {
         SceIoStat st{};
         if (!pathExists(matches[i], &st)) continue;
         if (isDirMode(st)) removeDirRecursive(matches[i]);
-        else sceIoRemove(matches[i].c_str());
+        else kfeIoRemove(matches[i]);
     }
 }
 }
@@ -142,7 +288,7 @@ bool KfeFileOps::sameDevice(const std::string& a, const std::string& b) {
 bool KfeFileOps::ensureDir(const std::string& path) {
     // create single level
     if (dirExists(path)) return true;
-    return sceIoMkdir(path.c_str(), 0777) >= 0;
+    return kfeIoMkdir(path) >= 0;
 }
 bool KfeFileOps::ensureDirRecursive(const std::string& full) {
     // make every segment after "ms0:/" or "ef0:/"
@@ -153,7 +299,7 @@ bool KfeFileOps::ensureDirRecursive(const std::string& full) {
         if (j == std::string::npos) j = full.size();
         std::string sub = full.substr(0, j);
         if (!dirExists(sub)) {
-            if (sceIoMkdir(sub.c_str(), 0777) < 0) return false;
+            if (kfeIoMkdir(sub) < 0) return false;
         }
         i = j + 1;
     }
@@ -163,6 +309,65 @@ bool KfeFileOps::isDirectoryPath(const std::string& path) {
     SceIoStat st{}; if (sceIoGetstat(path.c_str(), &st) < 0) return false;
     return FIO_S_ISDIR(st.st_mode);
 }
+// Re-read dst and compare against the CRC32 taken while the source was read.
+// The buffer is split in two so the next block is already being read
+// (sceIoReadAsync) while the current one is checksummed.
+bool KfeFileOps::verifyCopy(const std::string& dst, uint32_t expectCrc, uint64_t expectSize,
+                            uint8_t* buf, size_t bufSize, KernelFileExplorer* self) {
+    SceUID fd = sceIoOpen(dst.c_str(), PSP_O_RDONLY, 0);
+    if (fd < 0) { logf("  verify: open %s failed %d", dst.c_str(), fd); return false; }
+
+    const uint64_t shown = expectSize ? expectSize : 1;
+    std::string label;
+    if (self && self->msgBox) {
+        label = "Verifying " + basenameOf(dst);
+        self->msgBox->showProgress(label.c_str(), 0, shown);
+        self->renderProgressFrame();
+    }
+
+    const size_t half = (bufSize / 2) & ~(size_t)63;
+    bool async = half >= 4 * 1024;
+    const size_t block = async ? half : bufSize;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t done = 0;
+    bool ok = true;
+    int cur = 0;
+
+    bool pending = async && sceIoReadAsync(fd, buf, (SceSize)block) >= 0;
+    async = pending;
+    for (;;) {
+        uint8_t* data = buf + (size_t)cur * (async ? block : 0);
+        long long got;
+        if (async) {
+            SceInt64 res = 0;
+            pending = false;
+            if (sceIoWaitAsync(fd, &res) < 0) { ok = false; break; }
+            got = (long long)res;
+        } else {
+            got = sceIoRead(fd, data, (SceSize)block);
+        }
+        if (got < 0) { ok = false; break; }
+        if (got == 0) break;
+        if (async) {
+            cur ^= 1;
+            pending = sceIoReadAsync(fd, buf + (size_t)cur * block, (SceSize)block) >= 0;
+            if (!pending) { ok = false; break; }
+        }
+        crc = crc32(crc, data, (uInt)got);
+        done += (uint64_t)got;
+        if (self && self->msgBox) { self->msgBox->updateProgress(done, shown); self->renderProgressFrame(); }
+    }
+    if (pending) { SceInt64 res = 0; sceIoWaitAsync(fd, &res); }
+    sceIoClose(fd);
+
+    if (ok && (done != expectSize || (uint32_t)crc != expectCrc)) {
+        logf("  verify: %s mismatch (%llu/%llu bytes, crc %08X vs %08X)", dst.c_str(),
+             (unsigned long long)done, (unsigned long long)expectSize, (unsigned)crc, (unsigned)expectCrc);
+        ok = false;
+    }
+    return ok;
+}
+
 // Replace your copyFile with this hardened version.
 // NOTE: signature unchanged from your current integration that passes `this`.
 bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, KernelFileExplorer* self) {
@@ -183,23 +388,17 @@ bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, Kernel
         }
 
         SceUID out = sceIoOpen(dst.c_str(), PSP_O_WRONLY | PSP_O_CREAT | PSP_O_TRUNC, 0666);
+        kfeDirCacheInvalidate(dst);
         if (out < 0) { logf("  open dst failed %d", out); sceIoClose(in); return false; }
 
         uint64_t fileSize = 0;
         { SceIoStat st{}; if (sceIoGetstat(src.c_str(), &st) >= 0) fileSize = (uint64_t)st.st_size; if (!fileSize) fileSize = 1; }
 
-        if (self && self->msgBox) { self->msgBox->showProgress(basenameOf(src).c_str(), 0, fileSize); self->renderOneFrame(); }
+        if (self && self->msgBox) { self->msgBox->showProgress(basenameOf(src).c_str(), 0, fileSize); self->renderProgressFrame(); }
+        const unsigned long long copyT0 = nowUS();
 
-        size_t readBuf = 512 * 1024;
-        uint8_t* buf = (uint8_t*)malloc(readBuf);
-        if (!buf) {
-            readBuf = 128 * 1024;
-            buf = (uint8_t*)malloc(readBuf);
-        }
-        if (!buf) {
-            readBuf = 32 * 1024;
-            buf = (uint8_t*)malloc(readBuf);
-        }
+        size_t readBuf = 0;
+        uint8_t* buf = kfeIoBufferAcquire(kfeIoBufferSizeFor(src, dst), readBuf);
         if (!buf) {
             logf("  alloc read buffer failed");
             sceIoClose(in);
@@ -212,12 +411,15 @@ bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, Kernel
         const int MIN_WRITE_CHUNK = 4 * 1024;
 
         bool ok = true; uint64_t total = 0; int lastErr = 0;
+        const bool verify = self && self->opVerify;
+        uLong srcCrc = crc32(0L, Z_NULL, 0);
 
         auto destDev = std::string(dst.substr(0, 4)); // "ms0:" / "ef0:" (dst is "ef0:/...")
         for (;;) {
             int r = sceIoRead(in, buf, (int)readBuf);
             if (r < 0) { lastErr = r; logf("  read err %d", r); ok = false; break; }
             if (r == 0) break;
+            if (verify) srcCrc = crc32(srcCrc, buf, (uInt)r);
 
             int off = 0;
             while (off < r) {
@@ -255,7 +457,7 @@ bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, Kernel
                 off   += w;
                 total += (uint64_t)w;
 
-                if (self && self->msgBox) { self->msgBox->updateProgress(total, fileSize); self->renderOneFrame(); }
+                if (self && self->msgBox) { self->msgBox->updateProgress(total, fileSize); self->renderProgressFrame(); }
             }
 
             if (!ok) break;
@@ -264,18 +466,22 @@ bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, Kernel
 
         sceIoClose(in);
         sceIoClose(out);
-        free(buf);
+        if (ok && verify) ok = verifyCopy(dst, (uint32_t)srcCrc, total, buf, readBuf, self);
+        kfeIoBufferRelease();
 
         if (!ok) {
             logf("copyFile: FAIL after %llu/%llu bytes (err=%d)",
                 (unsigned long long)total, (unsigned long long)fileSize, lastErr);
-            sceIoRemove(dst.c_str()); // remove partial
-            if (self && self->msgBox) { self->msgBox->updateProgress(total, fileSize); self->renderOneFrame(); }
+            kfeIoRemove(dst); // remove partial
+            if (self && self->msgBox) { self->msgBox->updateProgress(total, fileSize); self->renderProgressFrame(true); }
             return false;
         }
 
-        if (self && self->msgBox) { self->msgBox->updateProgress(fileSize, fileSize); self->renderOneFrame(); }
-        logf("copyFile: OK %llu bytes", (unsigned long long)total);
+        if (self && self->msgBox) { self->msgBox->updateProgress(fileSize, fileSize); self->renderProgressFrame(); }
+        FreeSpaceAccount(dst, -(int64_t)total);
+        const unsigned long long copyUs = nowUS() - copyT0;
+        logf("copyFile: OK %llu bytes in %llu ms (%llu KiB/s)", (unsigned long long)total, copyUs / 1000ULL,
+             copyUs ? (unsigned long long)(total * 1000000ULL / copyUs / 1024ULL) : 0ULL);
         return true;
     };
 
@@ -294,10 +500,10 @@ bool KfeFileOps::copyFile(const std::string& src, const std::string& dst, Kernel
         logf("copyFile: critical destination missing after pass %d: %s", pass, dst.c_str());
         if (pass == 2) {
             sKfeCriticalGuardFailure = true;
-            sceIoRemove(dst.c_str());
+            kfeIoRemove(dst);
             return false;
         }
-        sceIoRemove(dst.c_str());
+        kfeIoRemove(dst);
         sceKernelDelayThread(2 * 1000);
     }
     return false;
@@ -313,19 +519,25 @@ bool KfeFileOps::removeDirRecursive(const std::string& dir) {
         std::string child = joinDirFile(dir, ent.d_name);
         if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
             removeDirRecursive(child);
-            sceIoRmdir(child.c_str());
+            kfeIoRmdir(child);
         } else {
-            sceIoRemove(child.c_str());
+            kfeIoRemove(child);
         }
         memset(&ent, 0, sizeof(ent));
         sceKernelDelayThread(0); // yield
     }
     kfeIoCloseDir(d);
-    return sceIoRmdir(dir.c_str()) >= 0;
+    return kfeIoRmdir(dir) >= 0;
 }
-bool KfeFileOps::copyDirRecursive(const std::string& src, const std::string& dst, KernelFileExplorer* self) {
-    logf("copyDirRecursive: %s -> %s", src.c_str(), dst.c_str());
-    if (!ensureDirRecursive(dst)) { logf("  ensureDirRecursive failed"); return false; }
+struct KfeDirCopyCtx {
+    uint8_t* buf = nullptr;
+    size_t   bufSize = 0;
+    std::vector<std::pair<std::string, std::string>> verify;   // fast-copied PBP/PRX (src, dst), checked at the end
+    int      smallFiles = 0;
+};
+
+bool KfeFileOps::copyDirWalk(const std::string& src, const std::string& dst,
+                             KernelFileExplorer* self, KfeDirCopyCtx& ctx) {
     SceUID d = kfeIoOpenDir(src.c_str());
     if (d < 0) { logf("  open src failed %d", d); return false; }
 
@@ -338,15 +550,61 @@ bool KfeFileOps::copyDirRecursive(const std::string& src, const std::string& dst
         std::string t = joinDirFile(dst, ent.d_name);
 
         if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
-            ok = ensureDir(t) && copyDirRecursive(s, t, self);
+            ok = ensureDir(t) && copyDirWalk(s, t, self, ctx);
         } else {
-            logf("  file: %s -> %s (%ld bytes)", s.c_str(), t.c_str(), (long)ent.d_stat.st_size);
-            ok = copyFile(s, t, self);
+            const SceOff size = ent.d_stat.st_size;
+            logf("  file: %s -> %s (%ld bytes)", s.c_str(), t.c_str(), (long)size);
+            const bool verify = self && self->opVerify;
+            uint32_t crc = 0;
+            if (ctx.buf && size <= KFE_SMALL_FILE_MAX && (size_t)size <= ctx.bufSize &&
+                kfeCopySmallFile(s, t, size, ctx.buf, ctx.bufSize, verify ? &crc : nullptr)) {
+                ++ctx.smallFiles;
+                if (verify && !verifyCopy(t, crc, (uint64_t)size, ctx.buf, ctx.bufSize, nullptr)) {
+                    logf("  fast copy failed verification, recopying: %s", t.c_str());
+                    kfeIoRemove(t);
+                    ok = copyFile(s, t, self);
+                    memset(&ent, 0, sizeof(ent));
+                    continue;
+                }
+                FreeSpaceAccount(t, -(int64_t)size);
+                if (kfeNeedsDestPresenceVerify(t)) ctx.verify.push_back({s, t});
+                if (self && self->msgBox) {
+                    self->msgBox->showProgress(ent.d_name, (uint64_t)size, size ? (uint64_t)size : 1);
+                    self->renderProgressFrame();
+                }
+            } else {
+                ok = copyFile(s, t, self);
+            }
         }
         memset(&ent, 0, sizeof(ent));
         sceKernelDelayThread(0); // yield
     }
     kfeIoCloseDir(d);
+    return ok;
+}
+bool KfeFileOps::copyDirRecursive(const std::string& src, const std::string& dst, KernelFileExplorer* self) {
+    logf("copyDirRecursive: %s -> %s", src.c_str(), dst.c_str());
+    if (!ensureDirRecursive(dst)) { logf("  ensureDirRecursive failed"); return false; }
+
+    KfeIoBufferScope ioBuf;   // keeps the buffer for the straggler recopies below
+    KfeDirCopyCtx ctx;
+    ctx.buf = kfeIoBufferAcquire(kfeIoBufferSizeFor(src, dst), ctx.bufSize);
+    bool ok = copyDirWalk(src, dst, self, ctx);
+    if (ctx.buf) { kfeIoBufferRelease(); ctx.buf = nullptr; }
+
+    // Deferred presence check for fast-copied PBP/PRX: one settle delay for the
+    // whole folder instead of one per file; stragglers get the full copyFile().
+    if (ok && !ctx.verify.empty()) {
+        bool settled = false;
+        for (size_t i = 0; ok && i < ctx.verify.size(); ++i) {
+            if (pathExists(ctx.verify[i].second)) continue;
+            if (!settled) { sceKernelDelayThread(8 * 1000); settled = true; }
+            if (pathExists(ctx.verify[i].second)) continue;
+            logf("  critical file missing after fast copy, recopying: %s", ctx.verify[i].second.c_str());
+            ok = copyFile(ctx.verify[i].first, ctx.verify[i].second, self);
+        }
+    }
+    logf("  %d small file(s) on the fast path", ctx.smallFiles);
     if (!ok) {
         // Avoid leaving half-copied directories behind on failure.
         removeDirRecursive(dst);
@@ -446,7 +704,11 @@ int KfeFileOps::kfeFastMoveDevctl(const char* src, const char* dst) {
     data[1] = (uint32_t)(c2 + 1);
 
     // 0x02415830 = FAT intra-volume move/rename (instant)
-    return pspIoDevctl(dev, 0x02415830, data, sizeof(data), nullptr, 0);
+    int rc = pspIoDevctl(dev, 0x02415830, data, sizeof(data), nullptr, 0);
+    kfeDirCacheInvalidate(src);
+    kfeDirCacheInvalidate(dst);
+    if (rc >= 0) kfeCatTopoOnRename(src, dst);
+    return rc;
 }
 
 // Execute move for one path
@@ -472,7 +734,7 @@ bool KfeFileOps::moveOne(const std::string& src, const std::string& dst, GameIte
     SceIoStat dstSt{};
     if (pathExists(dst, &dstSt) && REPLACE_ON_MOVE) {
         if (isDirMode(dstSt)) { logf("  dst exists (dir) -> removing"); removeDirRecursive(dst); }
-        else                  { logf("  dst exists (file)-> removing"); sceIoRemove(dst.c_str()); }
+        else                  { logf("  dst exists (file)-> removing"); kfeIoRemove(dst); }
     }
 
     // Same device? Prefer instant operations.
@@ -488,27 +750,27 @@ bool KfeFileOps::moveOne(const std::string& src, const std::string& dst, GameIte
         }
 
         if (kind == GameItem::ISO_FILE) {
-            int rr = sceIoRename(src.c_str(), dst.c_str());
+            int rr = kfeIoRename(src, dst);
             if (rr >= 0) {
                 if (!verifyCritical || kfeWaitForPathPresence(dst)) return true;
                 logf("  critical destination missing after rename, retrying once: %s", dst.c_str());
-                if (pathExists(src)) rr = sceIoRename(src.c_str(), dst.c_str());
+                if (pathExists(src)) rr = kfeIoRename(src, dst);
                 if (kfeWaitForPathPresence(dst)) return true;
                 sKfeCriticalGuardFailure = true;
                 return false;
             }
             // Fallback: same-device copy+delete -> show progress
             bool ok = copyFile(src, dst, self);
-            if (ok) sceIoRemove(src.c_str());
+            if (ok) kfeRemoveFileAccounted(src);
             return ok;
         } else {
-            int rr = sceIoRename(src.c_str(), dst.c_str());
+            int rr = kfeIoRename(src, dst);
             if (rr >= 0) return true;
 
-            if (fastMoveDirByRenames(src, dst)) { sceIoRmdir(src.c_str()); return true; }
+            if (fastMoveDirByRenames(src, dst)) { kfeIoRmdir(src); return true; }
 
             // Last resort: show progress per file while copying the tree
-            bool ok = copyDirRecursive(src, dst, self) && removeDirRecursive(src);
+            bool ok = copyDirRecursive(src, dst, self) && kfeRemoveDirAccounted(src);
             return ok;
         }
     }
@@ -516,10 +778,10 @@ bool KfeFileOps::moveOne(const std::string& src, const std::string& dst, GameIte
     // Cross-device: always copy+delete, with progress
     if (kind == GameItem::ISO_FILE) {
         bool ok = copyFile(src, dst, self);
-        if (ok) sceIoRemove(src.c_str());
+        if (ok) kfeRemoveFileAccounted(src);
         return ok;
     } else {
-        bool ok = copyDirRecursive(src, dst, self) && removeDirRecursive(src);
+        bool ok = copyDirRecursive(src, dst, self) && kfeRemoveDirAccounted(src);
         return ok;
     }
 }
@@ -532,24 +794,26 @@ bool KfeFileOps::removeFileWithProgress(const std::string& path, KernelFileExplo
         self->msgBox->showProgress(basenameOf(path).c_str(), 0, 1);
         self->renderOneFrame();
     }
-    int rc = sceIoRemove(path.c_str());
+    const bool ok = kfeRemoveFileAccounted(path);
     if (self && self->msgBox) {
         self->msgBox->updateProgress(1, 1);
         self->renderOneFrame();
     }
-    return rc >= 0;
+    return ok;
 }
 
-// Recursive folder delete that shows the current child name as we go
+// Recursive folder delete: snapshot the tree once, then remove in manifest
+// order with the current child name shown on a time budget.
 bool KfeFileOps::removeDirRecursiveProgress(const std::string& dir, KernelFileExplorer* self) {
-    SceUID d = kfeIoOpenDir(dir.c_str());
-    if (d < 0) {
-        // If open fails, try removing the directory itself (may already be empty/inaccessible)
+    std::vector<char> manifest;
+    PspIoTreeStats tree;
+    if (!kfeBuildDeleteManifest(dir, manifest, tree) && manifest.empty()) {
+        // Unreadable: try removing the directory itself (may already be empty/inaccessible)
         if (self && self->msgBox) {
             self->msgBox->showProgress(basenameOf(dir).c_str(), 0, 1);
             self->renderOneFrame();
         }
-        bool ok = (sceIoRmdir(dir.c_str()) >= 0);
+        bool ok = (kfeIoRmdir(dir) >= 0);
         if (self && self->msgBox) {
             self->msgBox->updateProgress(1, 1);
             self->renderOneFrame();
@@ -557,53 +821,45 @@ bool KfeFileOps::removeDirRecursiveProgress(const std::string& dir, KernelFileEx
         return ok;
     }
 
-    bool ok = true;
-    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-    while (ok && kfeIoReadDir(d, &ent) > 0) {
-        if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) {
-            memset(&ent, 0, sizeof(ent));
-            continue;
-        }
-        std::string child = joinDirFile(dir, ent.d_name);
-
-        // Update label to current child before removing
-        if (self && self->msgBox) {
-            self->msgBox->showProgress(ent.d_name, 0, 1);
-            self->renderOneFrame();
-        }
+    size_t total = 0;
+    for (size_t i = 0; i < manifest.size(); i += strlen(&manifest[i + 1]) + 2) ++total;
 
-        if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
-            // Recurse into subdir first
-            ok = removeDirRecursiveProgress(child, self);
-            if (ok) ok = (sceIoRmdir(child.c_str()) >= 0);
-        } else {
-            ok = (sceIoRemove(child.c_str()) >= 0);
-        }
+    const unsigned long long t0 = nowUS();
+    bool ok = true;
+    size_t done = 0, files = 0;
+    for (size_t i = 0; ok && i < manifest.size(); ) {
+        const char  kind = manifest[i];
+        const char* rel  = &manifest[i + 1];
+        i += strlen(rel) + 2;
+        const std::string child = joinDirFile(dir, rel);
 
-        // Mark this item finished
         if (self && self->msgBox) {
-            self->msgBox->updateProgress(1, 1);
-            self->renderOneFrame();
+            const char* leaf = strrchr(rel, '/');
+            self->msgBox->showProgress(leaf ? leaf + 1 : rel, done, total + 1);
+            self->renderProgressFrame();
         }
+        if (kind == 'D') ok = (kfeIoRmdir(child) >= 0);
+        else { ok = (kfeIoRemove(child) >= 0); ++files; }
+        if (!ok) logf("removeDirRecursiveProgress: %s %s failed", kind == 'D' ? "rmdir" : "remove", child.c_str());
 
-        memset(&ent, 0, sizeof(ent));
-        sceKernelDelayThread(0); // yield
+        if ((++done & 63) == 0) sceKernelDelayThread(0); // yield now and then
     }
-    kfeIoCloseDir(d);
 
-    // Finally remove the now-empty parent directory itself (show its name as a cue)
+    // Finally remove the now-empty parent directory itself
     if (ok) {
         if (self && self->msgBox) {
-            self->msgBox->showProgress(basenameOf(dir).c_str(), 0, 1);
-            self->renderOneFrame();
+            self->msgBox->showProgress(basenameOf(dir).c_str(), total, total + 1);
+            self->renderProgressFrame();
         }
-        ok = (sceIoRmdir(dir.c_str()) >= 0);
+        ok = (kfeIoRmdir(dir) >= 0);
         if (self && self->msgBox) {
             self->msgBox->updateProgress(1, 1);
-            self->renderOneFrame();
+            self->renderProgressFrame(true);
         }
     }
-
+    if (ok) FreeSpaceAccount(dir, (int64_t)tree.bytes, tree.files);
+    logf("removeDirRecursiveProgress: %s %u file(s), %u dir(s) in %llu ms%s", dir.c_str(),
+         (unsigned)files, (unsigned)(done - files), (nowUS() - t0) / 1000ULL, ok ? "" : " (FAIL)");
     return ok;
 }
 
@@ -622,28 +878,39 @@ void KfeFileOps::performDelete(KernelFileExplorer* self) {
     if (!self) return;
     ClockGuard cg; cg.boost333();
 
-    // Open progress box (no icon, centered bar + two text lines)
-    self->msgBox = new MessageBox("Deleting...", nullptr, SCREEN_WIDTH, SCREEN_HEIGHT, 1.0f, 0, "", 16, 18, 8, 14);
-    self->renderOneFrame();
+    // Progress box (no icon, centered bar + two text lines), only opened when
+    // an item can't go to the trash and has to be deleted in place.
+    auto openProgressBox = [&]() {
+        if (self->msgBox) return;
+        self->msgBox = new MessageBox("Deleting...", nullptr, SCREEN_WIDTH, SCREEN_HEIGHT, 1.0f, 0, "", 16, 18, 8, 14);
+        self->renderOneFrame();
+    };
 
-    int ok = 0, fail = 0;
+    KfeDirCacheScope dirCache;
+    DevPrefetchReset(false);
+    int ok = 0, fail = 0, trashed = 0;
     std::vector<std::string> deletedPaths;
     deletedPaths.reserve(self->opSrcPaths.size());
     for (size_t i = 0; i < self->opSrcPaths.size(); ++i) {
         const std::string& p = self->opSrcPaths[i];
         const GameItem::Kind k = self->opSrcKinds[i];
 
-        // NEW: show the cached game title (headline above the progress bar).
-        // Falls back to basename when no title is cached.
-        if (self->msgBox) {
+        // Instant path: rename into the volume's trash, purged in the background.
+        bool okOne = kfeTrashMove(p);
+        if (okOne) {
+            ++trashed;
+        } else {
+            openProgressBox();
+            // NEW: show the cached game title (headline above the progress bar).
+            // Falls back to basename when no title is cached.
             std::string title = self->getCachedTitleForPath(p);
             if (title.empty()) title = basenameOf(p);
             self->msgBox->setProgressTitle(title.c_str());
             self->renderOneFrame();
-        }
 
-        // Filename detail is already handled inside deleteOne(...) via showProgress/updateProgress.
-        bool okOne = deleteOne(p, k, self);
+            // Filename detail is already handled inside deleteOne(...) via showProgress/updateProgress.
+            okOne = deleteOne(p, k, self);
+        }
         if (okOne) {
             ok++;
             self->checked.erase(p);
@@ -654,7 +921,10 @@ void KfeFileOps::performDelete(KernelFileExplorer* self) {
         sceKernelDelayThread(0);
     }
 
+    dirCache.end();
     delete self->msgBox; self->msgBox = nullptr;
+    if (trashed) kfeTrashKick();
+    logf("performDelete: %d ok (%d via trash), %d failed", ok, trashed, fail);
 
     // Remove hidden filters for any paths we actually deleted
     if (!deletedPaths.empty()) {
@@ -704,6 +974,7 @@ void KfeFileOps::performDelete(KernelFileExplorer* self) {
     self->opSrcCount = 0;
     self->opSrcTotalBytes = 0;
     self->opPhase = KernelFileExplorer::OP_None;
+    self->frameDirty = true;
 }
 
 
@@ -719,7 +990,7 @@ bool KfeFileOps::copyOne(const std::string& src, const std::string& dst, GameIte
     SceIoStat dstSt{};
     if (pathExists(dst, &dstSt) && REPLACE_ON_MOVE) {
         if (isDirMode(dstSt)) removeDirRecursive(dst);
-        else sceIoRemove(dst.c_str());
+        else kfeIoRemove(dst);
     }
 
     if (kind == GameItem::ISO_FILE) {
@@ -73,6 +73,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <stdarg.h>
+#include <zlib.h>      // crc32
 #include <cmath>
 #include <set>
 
@@ -80,6 +81,10 @@
 #include "MessageBox.h"
 #include "iso_titles_extras.h"
 #include "kfe_app.h"
+#include "kfe_ui_pack.h"
+#include "kfe_fold.h"
+#include "kfe_cat_plan.h"
+#include "kfe_text_span.h"
 // Load the mass-storage stack in safe order. Always ms0; add ef0 on PSP Go.
 static int LoadStartKMod(const char* path);
 static bool DeviceExists(const char* root);
@@ -172,11 +177,34 @@ static std::string humanSize3(uint64_t bytes) {
 
 
 
+// Compact entry filled by fs_driver's pspIoReadDirBatch (keep in sync with fs_driver.c).
+typedef struct {
+    SceMode mode;
+    SceOff size;
+    ScePspDateTime ctime;
+    ScePspDateTime mtime;
+    char name[256];
+} PspIoDirEntryLite;
+
+// Totals filled by fs_driver's pspIoWalkTree (keep in sync with fs_driver.c).
+typedef struct {
+    u64 bytes;
+    u32 files;
+    u32 dirs;
+    u32 manifestUsed;
+    u32 truncated;
+    u32 clusterBytes;   // in: cluster size for allocBytes (0 = skip)
+    u32 reserved;
+    u64 allocBytes;     // out: files rounded up to clusters plus directory tables
+} PspIoTreeStats;
+
 // Stub out PSP IO functions so plugin builds
 extern "C" {
     int pspIoOpenDir(const char *dirname);
     int pspIoReadDir(SceUID dir, SceIoDirent *dirent);
     int pspIoCloseDir(SceUID dir);
+    int pspIoReadDirBatch(SceUID dir, PspIoDirEntryLite *out, int maxEntries);
+    int pspIoWalkTree(const char *root, PspIoTreeStats *stats, char *manifest, int manifestSize);
     int pspIoGetstat(const char *file, SceIoStat *stat);
     int pspIoChstat(const char *file, SceIoStat *stat, int bits);
     int sceIoOpen(const char *file, int flags, SceMode mode);
@@ -202,6 +230,10 @@ extern "C" {
 static SceUID kfeIoOpenDir(const char* path);
 static int kfeIoReadDir(SceUID dir, SceIoDirent* ent);
 static int kfeIoCloseDir(SceUID dir);
+static void kfeCatTopoOnRename(const std::string& from, const std::string& to);
+static void kfeCatTopoOnRemove(const std::string& path);
+static void kfeCatTopoTouched(const std::string& path, bool folderChange);
+static bool kfeFilterBatchOpen();
 
 // Path split helpers
 static std::string dirnameOf(const std::string& p) {
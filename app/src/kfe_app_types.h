@@ -61,7 +61,15 @@ int sceKernelRegisterExitCallback(int cbid);
 #endif
 
 // ===== Exit callback (HOME menu) =====
-static int ExitCallback(int, int, void*) { sceKernelExitGame(); return 0; }
+// Runs on CallbackThread, which preempts main: it never touches filter state.
+// While a GclFilterBatch is open the exit is only requested; main exits once
+// the outermost batch has written its files (or at the top of its loop).
+static volatile int gKfeExitRequested = 0;
+static int ExitCallback(int, int, void*) {
+    if (!kfeFilterBatchOpen()) sceKernelExitGame();
+    gKfeExitRequested = 1;
+    return 0;
+}
 static int CallbackThread(SceSize, void*) {
     int cb = sceKernelCreateCallback("ExitCallback", ExitCallback, nullptr);
     sceKernelRegisterExitCallback(cb);
@@ -93,12 +101,20 @@ static void updateMsLedForHomeAnim() {
     setMsLedSuppressed(gHomeAnimStreaming);
 }
 
+// UI thread (set at boot). The shared I/O bookkeeping below (log file,
+// user-mode dir handles, enumeration stats) belongs to it: worker threads
+// read directories through the kernel bridge only and don't log.
+static SceUID gKfeMainThread = -1;
+static inline bool kfeOnMainThread() {
+    return gKfeMainThread < 0 || sceKernelGetThreadId() == gKfeMainThread;
+}
+
 static constexpr bool kfeLoggingEnabled = false;
 static SceUID gLogFd = -1;
 static std::string gLogBaseDir;
 static inline void trimTrailingSpaces(char* s);
 static void logInit() {
-    if (!kfeLoggingEnabled) return;
+    if (!kfeLoggingEnabled || !kfeOnMainThread()) return;
     if (gLogFd >= 0) return;
     if (!gLogBaseDir.empty()) {
         std::string p = gLogBaseDir + "KFE_move.log";
@@ -107,37 +123,328 @@ static void logInit() {
     if (gLogFd < 0) gLogFd = sceIoOpen("ms0:/KFE_move.log", PSP_O_WRONLY | PSP_O_CREAT | PSP_O_APPEND, 0666);
     if (gLogFd < 0) gLogFd = sceIoOpen("ef0:/KFE_move.log", PSP_O_WRONLY | PSP_O_CREAT | PSP_O_APPEND, 0666);
 }
-static void logWrite(const char* s) { if (kfeLoggingEnabled && gLogFd >= 0) sceIoWrite(gLogFd, s, (int)strlen(s)); }
+static void logWrite(const char* s) {
+    if (kfeLoggingEnabled && gLogFd >= 0 && kfeOnMainThread()) sceIoWrite(gLogFd, s, (int)strlen(s));
+}
 static void logf(const char* fmt, ...) {
-    if (!kfeLoggingEnabled) return;
+    if (!kfeLoggingEnabled || !kfeOnMainThread()) return;
     char buf[512];
     va_list ap; va_start(ap, fmt);
     vsnprintf(buf, sizeof(buf), fmt, ap);
     va_end(ap);
     logWrite(buf); logWrite("\r\n");
 }
-static void logClose(){ if (kfeLoggingEnabled && gLogFd >= 0) { sceIoClose(gLogFd); gLogFd = -1; } }
+static void logClose(){ if (kfeLoggingEnabled && gLogFd >= 0 && kfeOnMainThread()) { sceIoClose(gLogFd); gLogFd = -1; } }
 
 // Fallback to user-mode dir I/O if kernel bridge fails on some CFWs (LME).
+// UI thread only; on workers every handle is a kernel-bridge one.
 static std::unordered_set<SceUID> gUserDirHandles;
 static SceUID kfeIoOpenDir(const char* path) {
     SceUID d = pspIoOpenDir(path);
-    if (d >= 0) return d;
+    if (d >= 0 || !kfeOnMainThread()) return d;
     SceUID ud = sceIoDopen(path);
     if (ud >= 0) gUserDirHandles.insert(ud);
     return ud;
 }
 static int kfeIoReadDir(SceUID dir, SceIoDirent* ent) {
-    if (gUserDirHandles.find(dir) != gUserDirHandles.end())
+    if (kfeOnMainThread() && gUserDirHandles.find(dir) != gUserDirHandles.end())
         return sceIoDread(dir, ent);
     return pspIoReadDir(dir, ent);
 }
 static int kfeIoCloseDir(SceUID dir) {
-    if (gUserDirHandles.erase(dir))
+    if (kfeOnMainThread() && gUserDirHandles.erase(dir))
         return sceIoDclose(dir);
     return pspIoCloseDir(dir);
 }
 
+// --- batched enumeration ---
+// pspIoReadDir pays one kernel transition (K1 + user level swap) per entry.
+// KfeDirReader pulls KFE_DIR_BATCH compact entries per transition through
+// pspIoReadDirBatch and hands them out one SceIoDirent at a time, so callers
+// keep their loops. User-mode handles (LME fallback) and an fs_driver.prx
+// without the export fall back to single reads. "." and ".." may still show
+// up on the fallback path; callers skip them as before.
+static constexpr bool kfeDirBatchEnabled = true;   // flip to compare timings in KFE_move.log
+static const int KFE_DIR_BATCH = 16;
+static bool gKfeDirBatchMissing = false;           // export not linked in the loaded PRX (UI thread)
+struct KfeEnumStats { unsigned entries = 0; unsigned calls = 0; unsigned long long us = 0; };
+static KfeEnumStats gKfeEnumStats;                 // reset/logged per scan (UI thread only)
+
+class KfeDirReader {
+public:
+    explicit KfeDirReader(const char* path) {
+        onMain = kfeOnMainThread();
+        d = kfeIoOpenDir(path);
+        // Workers skip the shared flags and find a missing export per reader.
+        batched = kfeDirBatchEnabled && d >= 0 &&
+                  (!onMain || (!gKfeDirBatchMissing && gUserDirHandles.find(d) == gUserDirHandles.end()));
+    }
+    ~KfeDirReader() { if (d >= 0) kfeIoCloseDir(d); free(buf); }
+    bool ok() const { return d >= 0; }
+
+    // Fills ent (zeroed first) with the next entry; false at end or on error.
+    bool next(SceIoDirent& ent) {
+        memset(&ent, 0, sizeof(ent));
+        if (d < 0) return false;
+        if (batched) {
+            if (pos >= count) {
+                if (done) return false;
+                if (!buf) buf = (PspIoDirEntryLite*)malloc(sizeof(PspIoDirEntryLite) * KFE_DIR_BATCH);
+                if (!buf) { batched = false; return nextSingle(ent); }
+                unsigned long long t0 = sceKernelGetSystemTimeWide();
+                int r = pspIoReadDirBatch(d, buf, KFE_DIR_BATCH);
+                countCall(t0);
+                if (r < 0 && first) {
+                    if (onMain && (unsigned)r == 0x8002013Au) gKfeDirBatchMissing = true;  // SCE_KERNEL_ERROR_LIBRARY_NOT_YET_LINKED
+                    batched = false;
+                    return nextSingle(ent);
+                }
+                first = false;
+                if (r <= 0) { done = true; return false; }
+                count = r; pos = 0;
+                if (r < KFE_DIR_BATCH) done = true;   // short batch: directory exhausted
+            }
+            const PspIoDirEntryLite& e = buf[pos++];
+            ent.d_stat.st_mode     = e.mode;
+            ent.d_stat.st_size     = e.size;
+            ent.d_stat.sce_st_ctime = e.ctime;
+            ent.d_stat.sce_st_mtime = e.mtime;
+            strncpy(ent.d_name, e.name, sizeof(ent.d_name) - 1);
+            if (onMain) gKfeEnumStats.entries++;
+            return true;
+        }
+        return nextSingle(ent);
+    }
+
+private:
+    bool nextSingle(SceIoDirent& ent) {
+        unsigned long long t0 = sceKernelGetSystemTimeWide();
+        int r = kfeIoReadDir(d, &ent);
+        countCall(t0);
+        if (r <= 0) return false;
+        if (onMain) gKfeEnumStats.entries++;
+        return true;
+    }
+    void countCall(unsigned long long t0) {
+        if (!onMain) return;
+        gKfeEnumStats.us += sceKernelGetSystemTimeWide() - t0;
+        gKfeEnumStats.calls++;
+    }
+    KfeDirReader(const KfeDirReader&);
+    KfeDirReader& operator=(const KfeDirReader&);
+
+    SceUID d = -1;
+    PspIoDirEntryLite* buf = nullptr;
+    int  count = 0, pos = 0;
+    bool batched = false, first = true, done = false;
+    bool onMain = true;
+};
+
+// --- short-lived case-insensitive directory listing cache ---
+// Only active while a KfeDirCacheScope is alive on the thread that opened it
+// (one scan or one file operation). Inside a scope, repeated case-insensitive
+// probes of the same directory (EBOOT/PARAM/ICON0 lookups, collision checks)
+// cost one enumeration per directory. Outside a scope every lookup hits the
+// disk exactly as before. Mutations made through the kfeIo* wrappers below
+// drop the affected listings.
+enum { KFE_DC_ANY = 0, KFE_DC_FILE = 1, KFE_DC_DIR = 2 };
+struct KfeDirCacheEntry {
+    std::string    name;     // on-disk spelling (trailing spaces trimmed)
+    unsigned int   mode;
+    SceOff         size;
+    ScePspDateTime mtime;
+};
+struct KfeDirListing {
+    std::vector<KfeDirCacheEntry> entries;                  // on-disk order, "." and ".." skipped
+    std::unordered_multimap<std::string, size_t> byFolded;  // lower-cased name -> index in entries
+};
+static int    gKfeDirCacheDepth = 0;
+static SceUID gKfeDirCacheOwner = -1;
+static std::unordered_map<std::string, KfeDirListing> gKfeDirCache;  // folded dir path -> listing
+
+static std::string kfeDirCacheKey(const std::string& dir) {
+    std::string k = kfeFoldCase(dir.c_str());
+    while (k.size() > 5 && k.back() == '/') k.pop_back();   // keep "ms0:/" intact
+    return k;
+}
+static inline bool kfeDirCacheActive() {
+    return gKfeDirCacheDepth > 0 && sceKernelGetThreadId() == gKfeDirCacheOwner;
+}
+
+// Returns the cached listing of dir (enumerating it on first use), or nullptr
+// when no scope is active on this thread or the directory can't be opened.
+static const KfeDirListing* kfeDirCacheListing(const std::string& dir) {
+    if (!kfeDirCacheActive()) return nullptr;
+    const std::string key = kfeDirCacheKey(dir);
+    auto it = gKfeDirCache.find(key);
+    if (it != gKfeDirCache.end()) return &it->second;
+
+    KfeDirReader rd(dir.c_str());
+    if (!rd.ok()) return nullptr;
+    KfeDirListing& L = gKfeDirCache[key];
+    SceIoDirent ent;
+    while (rd.next(ent)) {
+        trimTrailingSpaces(ent.d_name);
+        if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) continue;
+        KfeDirCacheEntry e;
+        e.name  = ent.d_name;
+        e.mode  = ent.d_stat.st_mode;
+        e.size  = ent.d_stat.st_size;
+        e.mtime = ent.d_stat.sce_st_mtime;
+        L.byFolded.insert(std::make_pair(kfeFoldCase(ent.d_name), L.entries.size()));
+        L.entries.push_back(e);
+    }
+    return &L;
+}
+
+// First entry (in on-disk order) named 'name' case-insensitively, filtered by kind.
+static const KfeDirCacheEntry* kfeDirCacheFind(const KfeDirListing& L, const char* name, int kind) {
+    auto range = L.byFolded.equal_range(kfeFoldCase(name));
+    const KfeDirCacheEntry* best = nullptr; size_t bestIdx = 0;
+    for (auto it = range.first; it != range.second; ++it) {
+        const KfeDirCacheEntry& e = L.entries[it->second];
+        const bool isDir = FIO_S_ISDIR(e.mode);
+        if ((kind == KFE_DC_FILE && isDir) || (kind == KFE_DC_DIR && !isDir)) continue;
+        if (!best || it->second < bestIdx) { best = &e; bestIdx = it->second; }
+    }
+    return best;
+}
+
+// Ordered name list with a case-folded hash index (Game Categories blacklist
+// and filters). Insertion order is kept for serialization; membership checks
+// are O(1). Mutable access marks the index stale and the next lookup rebuilds it.
+class KfeNameList {
+public:
+    typedef std::vector<std::string>::iterator       iterator;
+    typedef std::vector<std::string>::const_iterator const_iterator;
+
+    iterator begin() { stale = true; return v.begin(); }
+    iterator end()   { stale = true; return v.end(); }
+    const_iterator begin() const { return v.begin(); }
+    const_iterator end()   const { return v.end(); }
+    size_t size()  const { return v.size(); }
+    bool   empty() const { return v.empty(); }
+
+    void clear() { v.clear(); idx.clear(); stale = false; }
+    void push_back(const std::string& s) {
+        v.push_back(s);
+        if (!stale) idx.insert(kfeFoldCase(s.c_str()));
+    }
+    std::string&       operator[](size_t i)       { stale = true; return v[i]; }
+    const std::string& operator[](size_t i) const { return v[i]; }
+    iterator erase(iterator it) { stale = true; return v.erase(it); }
+    void swap(std::vector<std::string>& other) { v.swap(other); stale = true; }
+
+    // push_back unless already present (case-insensitive); true if added.
+    bool addUniqueFolded(const std::string& s) {
+        if (containsFolded(s)) return false;
+        push_back(s);
+        return true;
+    }
+
+    const std::vector<std::string>& items() const { return v; }
+    operator const std::vector<std::string>&() const { return v; }
+
+    bool containsFolded(const std::string& s) const {
+        if (stale) {
+            idx.clear();
+            for (const auto& w : v) idx.insert(kfeFoldCase(w.c_str()));
+            stale = false;
+        }
+        return idx.find(kfeFoldCase(s.c_str())) != idx.end();
+    }
+
+private:
+    std::vector<std::string> v;
+    mutable std::unordered_set<std::string> idx;
+    mutable bool stale = false;
+};
+
+// Drop listings affected by a change to 'path': its parent, itself and anything below it.
+static void kfeDirCacheInvalidate(const std::string& path) {
+    if (gKfeDirCache.empty()) return;
+    const std::string key = kfeDirCacheKey(path);
+    std::string parent = dirnameOf(key);
+    if (!parent.empty() && parent.back() == ':') parent.push_back('/');   // "ms0:" -> "ms0:/"
+    gKfeDirCache.erase(parent);
+    const std::string below = key + "/";
+    for (auto it = gKfeDirCache.begin(); it != gKfeDirCache.end(); ) {
+        if (it->first == key || it->first.compare(0, below.size(), below) == 0) it = gKfeDirCache.erase(it);
+        else ++it;
+    }
+}
+
+// >0 while a scan or file operation runs on the UI thread; the trash purger
+// (further down) backs off while it is set.
+static volatile int gKfeForegroundIo = 0;
+
+// RAII scope for one scan or file operation. Nested scopes on the owning
+// thread share the cache; scopes opened from other threads are no-ops.
+struct KfeDirCacheScope {
+    bool active = false;
+    KfeDirCacheScope() {
+        SceUID self = sceKernelGetThreadId();
+        if (gKfeDirCacheDepth == 0) gKfeDirCacheOwner = self;
+        else if (gKfeDirCacheOwner != self) return;
+        ++gKfeDirCacheDepth; active = true;
+        ++gKfeForegroundIo;
+    }
+    ~KfeDirCacheScope() { end(); }
+    void end() {
+        if (!active) return;
+        active = false;
+        --gKfeForegroundIo;
+        if (--gKfeDirCacheDepth == 0) { gKfeDirCache.clear(); gKfeDirCacheOwner = -1; }
+    }
+    KfeDirCacheScope(const KfeDirCacheScope&) = delete;
+    KfeDirCacheScope& operator=(const KfeDirCacheScope&) = delete;
+};
+
+// Mutating I/O that keeps the listing cache coherent.
+// The category topology (further down) is patched alongside.
+static int kfeIoMkdir(const std::string& p) {
+    int rc = sceIoMkdir(p.c_str(), 0777);
+    kfeDirCacheInvalidate(p); kfeCatTopoTouched(p, true);
+    return rc;
+}
+static int kfeIoRmdir(const std::string& p) {
+    int rc = sceIoRmdir(p.c_str());
+    kfeDirCacheInvalidate(p); if (rc >= 0) kfeCatTopoOnRemove(p);
+    return rc;
+}
+static int kfeIoRemove(const std::string& p) {
+    int rc = sceIoRemove(p.c_str());
+    kfeDirCacheInvalidate(p); kfeCatTopoTouched(p, false);
+    return rc;
+}
+static int kfeIoRename(const std::string& a, const std::string& b) {
+    int rc = sceIoRename(a.c_str(), b.c_str());
+    kfeDirCacheInvalidate(a); kfeDirCacheInvalidate(b);
+    if (rc >= 0) kfeCatTopoOnRename(a, b);
+    return rc;
+}
+
+// Case-insensitive lookup of one entry; returns the on-disk name or "".
+static std::string kfeFindNameCaseInsensitive(const std::string& dirNoSlash, const char* want, int kind) {
+    if (const KfeDirListing* L = kfeDirCacheListing(dirNoSlash)) {
+        const KfeDirCacheEntry* e = kfeDirCacheFind(*L, want, kind);
+        return e ? e->name : std::string();
+    }
+    SceUID d = kfeIoOpenDir(dirNoSlash.c_str());
+    if (d < 0) return {};
+    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
+    std::string out;
+    while (kfeIoReadDir(d, &ent) > 0) {
+        trimTrailingSpaces(ent.d_name);
+        const bool isDir = FIO_S_ISDIR(ent.d_stat.st_mode);
+        const bool kindOk = (kind == KFE_DC_ANY) || (kind == KFE_DC_DIR ? isDir : !isDir);
+        if (kindOk && strcasecmp(ent.d_name, want) == 0) { out = ent.d_name; break; }
+        memset(&ent, 0, sizeof(ent));
+    }
+    kfeIoCloseDir(d);
+    return out;
+}
+
 // Debug: log a short directory listing when a scan comes back empty.
 static void logDirSample(const std::string& path, int maxEntries = 20) {
     SceUID d = kfeIoOpenDir(path.c_str());
@@ -183,10 +490,175 @@ static inline bool pathExists(const std::string& p, SceIoStat* out=nullptr) {
 }
 static inline bool isDirMode(const SceIoStat& st){ return (st.st_mode & FIO_S_IFDIR) != 0; }
 
+// --- shared copy buffer ---
+// One 64-byte aligned buffer for every copy path (copyFile, copyFileBuffered),
+// allocated on first use. Acquires nest (a folder copy holds it while
+// copyFile() borrows it for a large file) and each must be paired with a
+// release; the buffer is freed when nobody holds it and no KfeIoBufferScope
+// (one move/copy batch) is open. Main thread only, like the copy paths.
+struct KfeIoBufferPool {
+    uint8_t* buf = nullptr;
+    size_t   size = 0;
+    int      depth = 0;
+    int      holders = 0;
+};
+static KfeIoBufferPool gKfeIoBuf;
+
+// Read size per device pair: same-media copies alternate read/write on one
+// card, so bigger reads save seeks; cross-device streams fine at 256 KiB.
+static size_t kfeIoBufferSizeFor(const std::string& src, const std::string& dst) {
+    return sameDevice(src, dst) ? 512 * 1024 : 256 * 1024;
+}
+
+// Returns the pool buffer (got <= want); nullptr if even 32 KiB won't fit.
+static uint8_t* kfeIoBufferAcquire(size_t want, size_t& got) {
+    if (!gKfeIoBuf.buf) {
+        // Allocate the largest size once so later pairs in the batch fit too.
+        static const size_t sizes[] = { 512 * 1024, 128 * 1024, 32 * 1024 };
+        for (size_t s : sizes) {
+            gKfeIoBuf.buf = (uint8_t*)memalign(64, s);
+            if (gKfeIoBuf.buf) { gKfeIoBuf.size = s; break; }
+        }
+    }
+    got = gKfeIoBuf.buf ? (want < gKfeIoBuf.size ? want : gKfeIoBuf.size) : 0;
+    if (gKfeIoBuf.buf) ++gKfeIoBuf.holders;
+    return gKfeIoBuf.buf;
+}
+static void kfeIoBufferFreeIfIdle() {
+    if (gKfeIoBuf.depth > 0 || gKfeIoBuf.holders > 0 || !gKfeIoBuf.buf) return;
+    free(gKfeIoBuf.buf);
+    gKfeIoBuf.buf = nullptr; gKfeIoBuf.size = 0;
+}
+// Pairs with a successful kfeIoBufferAcquire().
+static void kfeIoBufferRelease() {
+    if (gKfeIoBuf.holders <= 0) { logf("kfeIoBufferRelease: not held (unpaired release)"); return; }
+    --gKfeIoBuf.holders;
+    kfeIoBufferFreeIfIdle();
+}
+
+struct KfeIoBufferScope {
+    bool active = true;
+    KfeIoBufferScope() { ++gKfeIoBuf.depth; }
+    ~KfeIoBufferScope() { end(); }
+    void end() {
+        if (!active) return;
+        active = false;
+        --gKfeIoBuf.depth;
+        kfeIoBufferFreeIfIdle();
+    }
+    KfeIoBufferScope(const KfeIoBufferScope&) = delete;
+    KfeIoBufferScope& operator=(const KfeIoBufferScope&) = delete;
+};
+
+// --- CRC32 file digests, memoized by path + size + mtime ---
+// The memo is mirrored to KFE_digest.bin in the app folder, so a boot only
+// stats the installed plugin instead of hashing it again.
+struct KfeFileDigest { SceOff size; ScePspDateTime mtime; uint32_t crc; };
+static std::unordered_map<std::string, KfeFileDigest> gKfeDigestMemo;
+static std::string gKfeDigestMemoPath;   // empty until kfeDigestMemoLoad
+
+static const uint32_t KFE_DIGEST_MEMO_MAGIC = 0x314D444B;   // "KDM1"
+
+// Layout: magic, count, then per entry u16 path length, path, size, mtime, crc.
+static void kfeDigestMemoSave() {
+    if (gKfeDigestMemoPath.empty()) return;
+    std::string out;
+    auto put = [&out](const void* p, size_t n) { out.append((const char*)p, n); };
+    const uint32_t magic = KFE_DIGEST_MEMO_MAGIC, count = (uint32_t)gKfeDigestMemo.size();
+    put(&magic, sizeof(magic)); put(&count, sizeof(count));
+    for (const auto& kv : gKfeDigestMemo) {
+        const uint16_t len = (uint16_t)std::min<size_t>(kv.first.size(), 0xFFFF);
+        put(&len, sizeof(len)); put(kv.first.data(), len);
+        put(&kv.second.size, sizeof(kv.second.size));
+        put(&kv.second.mtime, sizeof(kv.second.mtime));
+        put(&kv.second.crc, sizeof(kv.second.crc));
+    }
+    SceUID fd = sceIoOpen(gKfeDigestMemoPath.c_str(), PSP_O_WRONLY | PSP_O_CREAT | PSP_O_TRUNC, 0777);
+    if (fd < 0) return;
+    const int wr = sceIoWrite(fd, out.data(), (SceSize)out.size());
+    sceIoClose(fd);
+    if (wr != (int)out.size()) sceIoRemove(gKfeDigestMemoPath.c_str());
+}
+
+// Boot: adopt the saved memo. Entries still have to match size + mtime.
+static void kfeDigestMemoLoad(const std::string& path) {
+    gKfeDigestMemoPath = path;
+    SceIoStat st{};
+    if (!pathExists(path, &st) || st.st_size < 8 || st.st_size > 64 * 1024) return;
+    std::vector<char> buf((size_t)st.st_size);
+    SceUID fd = sceIoOpen(path.c_str(), PSP_O_RDONLY, 0);
+    if (fd < 0) return;
+    const int rd = sceIoRead(fd, buf.data(), (SceSize)buf.size());
+    sceIoClose(fd);
+    if (rd != (int)buf.size()) return;
+
+    size_t pos = 0;
+    auto get = [&](void* p, size_t n) {
+        if (pos + n > buf.size()) return false;
+        memcpy(p, buf.data() + pos, n); pos += n;
+        return true;
+    };
+    uint32_t magic = 0, count = 0;
+    if (!get(&magic, sizeof(magic)) || magic != KFE_DIGEST_MEMO_MAGIC || !get(&count, sizeof(count))) return;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint16_t len = 0;
+        if (!get(&len, sizeof(len)) || pos + len > buf.size()) return;
+        std::string key(buf.data() + pos, len); pos += len;
+        KfeFileDigest d;
+        if (!get(&d.size, sizeof(d.size)) || !get(&d.mtime, sizeof(d.mtime)) || !get(&d.crc, sizeof(d.crc))) return;
+        gKfeDigestMemo[key] = d;
+    }
+}
+
+// FAT mtimes are 2s-granular, so callers that rewrite a file drop the memo
+// (and its saved copy).
+static void kfeDigestForget() {
+    if (gKfeDigestMemo.empty()) return;
+    gKfeDigestMemo.clear();
+    if (!gKfeDigestMemoPath.empty()) sceIoRemove(gKfeDigestMemoPath.c_str());
+}
+
+static bool kfeFileCrc32(const std::string& path, uint32_t& crcOut, SceOff* sizeOut = nullptr) {
+    SceIoStat st{};
+    if (!pathExists(path, &st) || isDirMode(st)) return false;
+    auto it = gKfeDigestMemo.find(path);
+    if (it != gKfeDigestMemo.end() && it->second.size == st.st_size &&
+        memcmp(&it->second.mtime, &st.sce_st_mtime, sizeof(ScePspDateTime)) == 0) {
+        crcOut = it->second.crc;
+        if (sizeOut) *sizeOut = st.st_size;
+        return true;
+    }
+
+    SceUID fd = sceIoOpen(path.c_str(), PSP_O_RDONLY, 0);
+    if (fd < 0) return false;
+    unsigned char buf[16 * 1024];
+    uLong crc = crc32(0L, Z_NULL, 0);
+    SceOff total = 0;
+    for (;;) {
+        int rd = sceIoRead(fd, buf, sizeof(buf));
+        if (rd < 0) { sceIoClose(fd); return false; }
+        if (rd == 0) break;
+        crc = crc32(crc, buf, (uInt)rd);
+        total += rd;
+    }
+    sceIoClose(fd);
+    if (total != st.st_size) return false;
+
+    KfeFileDigest d;
+    d.size = st.st_size;
+    d.mtime = st.sce_st_mtime;
+    d.crc = (uint32_t)crc;
+    gKfeDigestMemo[path] = d;
+    kfeDigestMemoSave();
+    crcOut = d.crc;
+    if (sizeOut) *sizeOut = st.st_size;
+    return true;
+}
+
 // --- mkdir (no error if already exists) ---
 static bool ensureDir(const std::string& dirNoSlash) {
     if (dirExists(dirNoSlash)) return true;
-    int rc = sceIoMkdir(dirNoSlash.c_str(), 0777);
+    int rc = kfeIoMkdir(dirNoSlash);
     return (rc >= 0) || dirExists(dirNoSlash);
 }
 static bool ensureDirRecursive(const std::string& fullDir) {
@@ -224,18 +696,18 @@ static bool __attribute__((unused)) isDirEmpty(const std::string& dir) {
 // --- remove recursively (you already have a version; keep one) ---
 static bool removeDirRecursive(const std::string& dir) {
     SceUID d = kfeIoOpenDir(dir.c_str());
-    if (d < 0) return sceIoRmdir(dir.c_str()) >= 0;
+    if (d < 0) return kfeIoRmdir(dir) >= 0;
     SceIoDirent ent; memset(&ent, 0, sizeof(ent));
     while (kfeIoReadDir(d, &ent) > 0) {
         if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) { memset(&ent,0,sizeof(ent)); continue; }
         std::string child = joinDirFile(dir, ent.d_name);
         if (FIO_S_ISDIR(ent.d_stat.st_mode)) removeDirRecursive(child);
-        else sceIoRemove(child.c_str());
+        else kfeIoRemove(child);
         memset(&ent, 0, sizeof(ent));
         sceKernelDelayThread(0);
     }
     kfeIoCloseDir(d);
-    return sceIoRmdir(dir.c_str()) >= 0;
+    return kfeIoRmdir(dir) >= 0;
 }
 
 // --- fast per-file rename based folder move (same device, no data copy) ---
@@ -256,16 +728,17 @@ static bool fastMoveDirByRenames(const std::string& srcDir, const std::string& d
         if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
             // move subtree first
             ok = fastMoveDirByRenames(s, t);
-            if (ok) sceIoRmdir(s.c_str());
+            if (ok) kfeIoRmdir(s);
         } else {
             // if target file exists, remove it (replace semantics)
-            if (pathExists(t)) sceIoRemove(t.c_str());
-            int rr = sceIoRename(s.c_str(), t.c_str());
+            if (pathExists(t)) kfeIoRemove(t);
+            int rr = kfeIoRename(s, t);
             if (rr < 0) {
                 // rename refused (some drivers); fall back to real copy for this file
                 logf("  rename file -> %d; falling back to copy", rr);
                 SceUID in = sceIoOpen(s.c_str(), PSP_O_RDONLY, 0);
                 SceUID out = sceIoOpen(t.c_str(), PSP_O_WRONLY | PSP_O_CREAT | PSP_O_TRUNC, 0666);
+                kfeDirCacheInvalidate(t);
                 if (in < 0 || out < 0) { if (in >= 0) sceIoClose(in); if (out >= 0) sceIoClose(out); ok = false; }
                 else {
                     const int BUF = 128 * 1024; std::vector<uint8_t> buf(BUF);
@@ -283,7 +756,7 @@ static bool fastMoveDirByRenames(const std::string& srcDir, const std::string& d
                         sceKernelDelayThread(0);
                     }
                     sceIoClose(in); sceIoClose(out);
-                    if (ok) sceIoRemove(s.c_str());
+                    if (ok) kfeIoRemove(s);
                 }
             }
         }
@@ -295,23 +768,92 @@ static bool fastMoveDirByRenames(const std::string& srcDir, const std::string& d
     return ok;
 }
 
+// --- kernel-side tree walk ---
+// pspIoWalkTree totals a whole tree (and optionally lists it) in one kernel
+// call, without a user<->kernel round trip or std::string per child.
+// Returns false when the loaded fs_driver.prx lacks the export or the walk
+// failed; callers then keep their user-mode walk. clusterBytes != 0 also
+// asks for st.allocBytes (left 0 by drivers that predate it).
+static bool gKfeWalkTreeMissing = false;
+static bool kfeWalkTree(const std::string& root, PspIoTreeStats& st, std::vector<char>* manifest,
+                        uint32_t clusterBytes = 0) {
+    memset(&st, 0, sizeof(st));
+    st.clusterBytes = clusterBytes;
+    if (gKfeWalkTreeMissing) return false;
+    size_t cap = manifest ? (64u << 10) : 0;
+    for (;;) {
+        if (manifest) manifest->resize(cap);
+        int r = pspIoWalkTree(root.c_str(), &st,
+                              manifest ? manifest->data() : nullptr, (int)cap);
+        if ((unsigned)r == 0x8002013Au) { gKfeWalkTreeMissing = true; return false; }  // not linked
+        if (r < 0) { logf("kfeWalkTree: %s failed 0x%08X", root.c_str(), (unsigned)r); return false; }
+        if (!manifest) return true;
+        if (!st.truncated) { manifest->resize(st.manifestUsed); return true; }
+        if (cap >= (2u << 20)) { manifest->clear(); return false; }   // absurdly large tree: walk in user mode
+        cap *= 4;
+    }
+}
+
 // --- size calculators (for preflight) ---
-static bool sumDirBytes(const std::string& dir, uint64_t& out) {
-    logf("sumDirBytes: enter %s (start=%llu)", dir.c_str(), (unsigned long long)out);
-    SceUID d = kfeIoOpenDir(dir.c_str()); if (d < 0) return false;
-    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-    while (kfeIoReadDir(d, &ent) > 0) {
-        if (!strcmp(ent.d_name,".") || !strcmp(ent.d_name,"..")) { memset(&ent,0,sizeof(ent)); continue; }
+static bool sumDirBytesWalk(const std::string& dir, uint64_t& out) {
+    KfeDirReader rd(dir.c_str()); if (!rd.ok()) return false;
+    SceIoDirent ent;
+    while (rd.next(ent)) {
+        if (!strcmp(ent.d_name,".") || !strcmp(ent.d_name,"..")) continue;
         std::string p = joinDirFile(dir, ent.d_name);
-        if (FIO_S_ISDIR(ent.d_stat.st_mode)) { if (!sumDirBytes(p, out)) { kfeIoCloseDir(d); return false; } }
+        if (FIO_S_ISDIR(ent.d_stat.st_mode)) { if (!sumDirBytesWalk(p, out)) return false; }
         else out += (uint64_t)ent.d_stat.st_size;
-        memset(&ent, 0, sizeof(ent));
     }
-    kfeIoCloseDir(d);
+    return true;
+}
+static bool sumDirBytes(const std::string& dir, uint64_t& out) {
+    logf("sumDirBytes: enter %s (start=%llu)", dir.c_str(), (unsigned long long)out);
+    PspIoTreeStats st;
+    if (kfeWalkTree(dir, st, nullptr)) {
+        out += (uint64_t)st.bytes;
+        logf("sumDirBytes: kernel walk %s files=%u dirs=%u (now=%llu)",
+             dir.c_str(), (unsigned)st.files, (unsigned)st.dirs, (unsigned long long)out);
+        return true;
+    }
+    if (!sumDirBytesWalk(dir, out)) return false;
     logf("sumDirBytes: leave %s (now=%llu)", dir.c_str(), (unsigned long long)out);
     return true;
 }
 
+// What a tree occupies on a volume with the given cluster size: every file
+// rounded up to whole clusters, plus each directory's own entry table
+// (".", "..", and a short + long-name entry set per child).
+static uint64_t kfeRoundCluster(uint64_t n, uint32_t cluster) {
+    return (n + cluster - 1) / cluster * cluster;
+}
+static uint32_t kfeDirEntBytes(const char* name) {
+    return 32u * (1u + (uint32_t)(strlen(name) + 12) / 13u);
+}
+static bool sumDirAllocWalk(const std::string& dir, uint32_t cluster, uint64_t& out) {
+    KfeDirReader rd(dir.c_str()); if (!rd.ok()) return false;
+    SceIoDirent ent;
+    uint64_t table = 64;
+    while (rd.next(ent)) {
+        if (!strcmp(ent.d_name,".") || !strcmp(ent.d_name,"..")) continue;
+        table += kfeDirEntBytes(ent.d_name);
+        if (FIO_S_ISDIR(ent.d_stat.st_mode)) {
+            if (!sumDirAllocWalk(joinDirFile(dir, ent.d_name), cluster, out)) return false;
+        } else {
+            out += kfeRoundCluster((uint64_t)ent.d_stat.st_size, cluster);
+        }
+    }
+    out += kfeRoundCluster(table, cluster);
+    return true;
+}
+static bool sumDirAlloc(const std::string& dir, uint32_t cluster, uint64_t& out) {
+    PspIoTreeStats st;
+    if (kfeWalkTree(dir, st, nullptr, cluster) && st.allocBytes) {
+        out += (uint64_t)st.allocBytes;
+        return true;
+    }
+    return sumDirAllocWalk(dir, cluster, out);
+}
+
 // add near the other helpers
 static void __attribute__((unused)) hexdump(const void* p, size_t n) {
     if (!p || n == 0) return;
@@ -355,7 +897,8 @@ typedef struct {
 } CMF_SystemDevCommand;
 
 // Returns true on success; out = free bytes. Uses dev "ms0:" / "ef0:" (with or without slash OK).
-static bool getFreeBytesCMF(const char* devMaybeSlash, uint64_t& outFree) {
+// outClusterBytes (optional) receives the allocation unit size.
+static bool getFreeBytesCMF(const char* devMaybeSlash, uint64_t& outFree, uint32_t* outClusterBytes = nullptr) {
     outFree = 0;
     if (!devMaybeSlash || std::strlen(devMaybeSlash) < 4) return false;
 
@@ -370,6 +913,7 @@ static bool getFreeBytesCMF(const char* devMaybeSlash, uint64_t& outFree) {
     if (rc < 0 || devctl.sectorSize == 0) return false;
 
     outFree = (u64)devctl.freeClusters * devctl.sectorCount * devctl.sectorSize;
+    if (outClusterBytes) *outClusterBytes = (uint32_t)(devctl.sectorCount * devctl.sectorSize);
     return true;
 }
 
@@ -402,8 +946,18 @@ struct FreeSpaceCache {
     volatile int paused    = 0;  // 1 = pause worker
     volatile int pausedAck = 0;  // worker says "I am paused"
 
+    // cluster size per device (from the last probe; 0 = unknown)
+    volatile uint32_t ms0Cluster = 0;
+    volatile uint32_t ef0Cluster = 0;
+
     // age bookkeeping (microseconds since boot)
     volatile unsigned long long lastUS = 0;
+    // running sum of FreeSpaceAccount per device; a probe adds whatever
+    // accumulated while it ran instead of starting over
+    volatile int64_t ms0Delta = 0;
+    volatile int64_t ef0Delta = 0;
+    // bumped by FreeSpaceForget; a probe that straddles one is redone
+    volatile unsigned forgetGen = 0;
 
     // thread plumbing
     SceUID threadId = -1;
@@ -422,6 +976,16 @@ static inline unsigned long long nowUS() {
     return (unsigned long long)sceKernelGetSystemTimeWide();
 }
 
+// Progress boxes repaint at ~15 fps; I/O loops never wait on vblank per chunk.
+static const unsigned long long KFE_PROGRESS_PAINT_US = 66 * 1000;
+
+// The main loop only repaints when something changed. Background workers
+// bump this when they publish a result the UI shows; an idle screen still
+// repaints every KFE_IDLE_PAINT_US (clock, icon retries).
+static volatile unsigned gKfeUiGen = 0;
+static inline void kfeUiPoke() { gKfeUiGen++; }
+static const unsigned long long KFE_IDLE_PAINT_US = 500 * 1000;
+
 // Non-blocking getter (returns whatever we have, ok==0 means "unknown")
 static bool FreeSpaceGet(const char* dev4, uint64_t& outBytes, bool& ok, unsigned long long* outAgeUS = nullptr) {
     if (!dev4) { ok = false; outBytes = 0; return false; }
@@ -442,6 +1006,80 @@ static void FreeSpaceRequestRefresh() {
     if (gFSC.semId >= 0) sceKernelSignalSema(gFSC.semId, 1);
 }
 
+// Between probes the cached numbers are kept current from completed file
+// operations (FreeSpaceAccount); a real probe trues them up at most this old.
+static const unsigned long long KFE_FREESPACE_TRUEUP_US = 30ull * 1000 * 1000;
+
+static volatile uint64_t* FreeSpaceSlot(const char* dev, volatile int** ok, volatile uint32_t** cluster,
+                                        volatile int64_t** delta = nullptr) {
+    if (!dev) return nullptr;
+    if (!strncasecmp(dev, "ms0:", 4)) {
+        *ok = &gFSC.ms0Ok; *cluster = &gFSC.ms0Cluster;
+        if (delta) *delta = &gFSC.ms0Delta;
+        return &gFSC.ms0Free;
+    }
+    if (!strncasecmp(dev, "ef0:", 4)) {
+        *ok = &gFSC.ef0Ok; *cluster = &gFSC.ef0Cluster;
+        if (delta) *delta = &gFSC.ef0Delta;
+        return &gFSC.ef0Free;
+    }
+    return nullptr;
+}
+
+static uint64_t FreeSpaceWithDelta(uint64_t bytes, int64_t delta) {
+    if (delta >= 0) return bytes + (uint64_t)delta;
+    return (bytes > (uint64_t)-delta) ? bytes - (uint64_t)-delta : 0;
+}
+
+// Cluster size of dev ("ms0:..."/"ef0:..."); 32 KiB (FAT32 default) until probed.
+static uint32_t FreeSpaceClusterBytes(const char* dev) {
+    volatile int* ok = nullptr; volatile uint32_t* cl = nullptr;
+    if (!FreeSpaceSlot(dev, &ok, &cl) || *cl == 0) return 32 * 1024;
+    return *cl;
+}
+
+// Apply a completed operation to the cached free space of path's device.
+// bytes > 0 frees space, < 0 uses it. files > 1 means bytes is a total over
+// that many files; each is assumed to waste half a cluster on average.
+static void FreeSpaceAccount(const std::string& path, int64_t bytes, unsigned files = 1) {
+    volatile int* ok = nullptr; volatile uint32_t* cl = nullptr; volatile int64_t* delta = nullptr;
+    volatile uint64_t* slot = FreeSpaceSlot(path.c_str(), &ok, &cl, &delta);
+    if (!slot || bytes == 0) return;
+    const uint64_t c = *cl ? *cl : 32 * 1024;
+    uint64_t mag = (uint64_t)(bytes < 0 ? -bytes : bytes);
+    if (files > 1) mag += (uint64_t)files * (c / 2);
+    mag = (mag + c - 1) / c * c;
+    const int64_t d = (bytes > 0) ? (int64_t)mag : -(int64_t)mag;
+    *delta = *delta + d;
+    if (*ok) *slot = FreeSpaceWithDelta(*slot, d);
+}
+
+// Drop cached numbers (after USB mode, where the host changed the volume)
+// and have the worker re-probe right away.
+static void FreeSpaceForget() {
+    gFSC.forgetGen++;
+    gFSC.ms0Ok = 0; gFSC.ef0Ok = 0;
+    FreeSpaceRequestRefresh();
+}
+
+// Cached free space, probing synchronously (and seeding the cache) only when
+// nothing is known yet. Old entries get a background true-up.
+static bool FreeSpaceQuery(const char* dev, uint64_t& outBytes) {
+    bool ok = false; unsigned long long age = 0;
+    FreeSpaceGet(dev, outBytes, ok, &age);
+    if (ok) {
+        if (age > KFE_FREESPACE_TRUEUP_US && gFSC.threadId >= 0 && !gFSC.pending) FreeSpaceRequestRefresh();
+        return true;
+    }
+    volatile int* okp = nullptr; volatile uint32_t* cl = nullptr;
+    volatile uint64_t* slot = FreeSpaceSlot(dev, &okp, &cl);
+    uint32_t cluster = 0;
+    if (!slot || !getFreeBytesCMF(dev, outBytes, &cluster)) return false;
+    *slot = outBytes; *cl = cluster; *okp = 1;
+    if (!gFSC.lastUS) gFSC.lastUS = nowUS();
+    return true;
+}
+
 // Update which devices exist (call from detectRoots)
 static void FreeSpaceSetPresence(bool hasMs, bool hasEf) {
     gFSC.hasMs0 = hasMs ? 1 : 0;
@@ -476,27 +1114,47 @@ static int FreeSpaceThread(SceSize, void*) {
         if (!gFSC.pending) continue;
 
         gFSC.pending = 0;
+        const unsigned gen = gFSC.forgetGen;
+        // Operations that finish while a device is probed are added on top at
+        // the end; one finishing right at the probe may count twice, which the
+        // next true-up corrects. Either way a busy copy can't starve the probe.
+        int64_t ms0D = 0, ef0D = 0;
 
         uint64_t ms0B = 0, ef0B = 0;
+        uint32_t ms0C = 0, ef0C = 0;
         int msOk = 0, efOk = 0;
 
         // Probe ms0, but bail out immediately if paused
         if (!gFSC.paused && gFSC.hasMs0) {
             uint64_t v = 0;
-            if (getFreeBytesCMF("ms0:", v)) { ms0B = v; msOk = 1; }
+            ms0D = gFSC.ms0Delta;
+            if (getFreeBytesCMF("ms0:", v, &ms0C)) { ms0B = v; msOk = 1; }
         }
         if (gFSC.paused) { gFSC.pausedAck = 1; continue; }
 
         // Probe ef0, ditto
         if (!gFSC.paused && gFSC.hasEf0) {
             uint64_t v = 0;
-            if (getFreeBytesCMF("ef0:", v)) { ef0B = v; efOk = 1; }
+            ef0D = gFSC.ef0Delta;
+            if (getFreeBytesCMF("ef0:", v, &ef0C)) { ef0B = v; efOk = 1; }
         }
         if (gFSC.paused) { gFSC.pausedAck = 1; continue; }
 
-        gFSC.ms0Free = ms0B; gFSC.ms0Ok = msOk;
-        gFSC.ef0Free = ef0B; gFSC.ef0Ok = efOk;
+        // USB mode ended mid-probe: the host may have changed the volume
+        // after we read it (FreeSpaceForget already queued another probe).
+        if (gen != gFSC.forgetGen) continue;
+
+        // Only replace what was probed; the other device keeps its accounted value.
+        if (gFSC.hasMs0) {
+            gFSC.ms0Free = FreeSpaceWithDelta(ms0B, gFSC.ms0Delta - ms0D);
+            gFSC.ms0Ok = msOk; if (msOk) gFSC.ms0Cluster = ms0C;
+        }
+        if (gFSC.hasEf0) {
+            gFSC.ef0Free = FreeSpaceWithDelta(ef0B, gFSC.ef0Delta - ef0D);
+            gFSC.ef0Ok = efOk; if (efOk) gFSC.ef0Cluster = ef0C;
+        }
         gFSC.lastUS  = nowUS();
+        kfeUiPoke();
     }
     return 0;
 }
@@ -547,6 +1205,134 @@ static void FreeSpaceResume() {
     if (gFSC.semId >= 0) sceKernelSignalSema(gFSC.semId, 1);
 }
 
+// ===== Deferred delete ("trash") =====
+// performDelete renames items into <root>.kfe_trash/ (instant, same volume)
+// and a low-priority worker removes them afterwards. The worker only touches
+// paths under the trash folders and uses raw sceIo* calls, so it never shares
+// the UI thread's listing cache. It steps aside while a scan/file operation
+// (gKfeForegroundIo) or USB mode is active, and whatever is left over is
+// purged on the next launch.
+static const char* KFE_TRASH_DIR = ".kfe_trash";
+
+struct KfeTrash {
+    SceUID threadId = -1;
+    SceUID semId = -1;
+    volatile int pending = 0;
+    volatile int busy = 0;          // a purge pass is running
+    volatile int paused = 0;        // USB mode: stay off the volumes
+    volatile int pausedAck = 0;     // worker is parked (no sceIo* in flight)
+    unsigned seq = 0;               // unique suffix for trash names (UI thread)
+};
+static KfeTrash gKfeTrash;
+
+// "ms0:/.kfe_trash" for any "ms0:/..." path; "" if path has no device root.
+static std::string kfeTrashDirFor(const std::string& path) {
+    if (path.size() < 5 || path[3] != ':' || path[4] != '/') return std::string();
+    return path.substr(0, 5) + KFE_TRASH_DIR;
+}
+
+static bool kfeTrashShouldYield() {
+    return gKfeForegroundIo > 0 || gUsbActive || gKfeTrash.paused;
+}
+
+// Worker side: park until the UI thread is done with the filesystem.
+static void kfeTrashWaitTurn() {
+    while (kfeTrashShouldYield()) {
+        if (gKfeTrash.paused) gKfeTrash.pausedAck = 1;
+        sceKernelDelayThread(100 * 1000);
+    }
+}
+
+// Before USB mode (like DevPrefetchReset(true)): returns once the worker
+// is idle or parked between entries.
+static void kfeTrashPauseNow() {
+    gKfeTrash.paused = 1;
+    while (gKfeTrash.busy && !gKfeTrash.pausedAck) sceKernelDelayThread(1000);
+}
+
+static void kfeTrashResume() {
+    gKfeTrash.paused = 0;
+    gKfeTrash.pausedAck = 0;
+}
+
+// Same packed order as pspIoWalkTree's manifest, from plain user-mode reads.
+// Recursive like the DevPrefetch walk, hence the same 64 KiB worker stack.
+static void kfeTrashCollect(const std::string& dir, const std::string& rel, std::vector<char>& out) {
+    std::vector<std::pair<std::string, bool>> kids;
+    SceUID d = sceIoDopen(dir.c_str());
+    if (d < 0) return;
+    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
+    while (sceIoDread(d, &ent) > 0) {
+        if (strcmp(ent.d_name, ".") && strcmp(ent.d_name, ".."))
+            kids.push_back({ent.d_name, FIO_S_ISDIR(ent.d_stat.st_mode)});
+        memset(&ent, 0, sizeof(ent));
+    }
+    sceIoDclose(d);
+    for (const auto& k : kids) {
+        const std::string sub = rel.empty() ? k.first : rel + "/" + k.first;
+        if (k.second) kfeTrashCollect(dir + "/" + k.first, sub, out);
+        out.push_back(k.second ? 'D' : 'F');
+        out.insert(out.end(), sub.begin(), sub.end());
+        out.push_back('\0');
+    }
+}
+
+// Empties one trash folder; false if it had to stop early.
+static bool kfeTrashPurgeRoot(const std::string& trash) {
+    kfeTrashWaitTurn();
+    SceIoStat st{};
+    if (sceIoGetstat(trash.c_str(), &st) < 0) return true;
+
+    std::vector<char> manifest;
+    PspIoTreeStats ts;
+    if (!kfeWalkTree(trash, ts, &manifest)) { manifest.clear(); kfeTrashCollect(trash, std::string(), manifest); }
+
+    unsigned removed = 0;
+    for (size_t i = 0; i < manifest.size(); ) {
+        kfeTrashWaitTurn();
+        const char  kind = manifest[i];
+        const char* rel  = &manifest[i + 1];
+        i += strlen(rel) + 2;
+        const std::string p = trash + "/" + rel;
+        if (kind == 'D') sceIoRmdir(p.c_str());
+        else sceIoRemove(p.c_str());
+        if ((++removed & 15) == 0) sceKernelDelayThread(1000);   // keep the UI responsive
+    }
+    const bool empty = sceIoRmdir(trash.c_str()) >= 0;
+    logf("trash: purged %u entries from %s%s", removed, trash.c_str(), empty ? "" : " (not empty)");
+    return empty;
+}
+
+static int KfeTrashThread(SceSize, void*) {
+    for (;;) {
+        sceKernelWaitSema(gKfeTrash.semId, 1, nullptr);
+        while (gKfeTrash.pending) {
+            gKfeTrash.pending = 0;
+            gKfeTrash.busy = 1;
+            kfeTrashPurgeRoot(std::string("ms0:/") + KFE_TRASH_DIR);
+            kfeTrashPurgeRoot(std::string("ef0:/") + KFE_TRASH_DIR);
+            gKfeTrash.busy = 0;
+            FreeSpaceRequestRefresh();
+        }
+    }
+    return 0;
+}
+
+// Wake (and on first use start) the purger. Called after deletes and once at
+// boot so an interrupted purge finishes.
+static void kfeTrashKick() {
+    if (gKfeTrash.threadId < 0) {
+        gKfeTrash.semId = sceKernelCreateSema("KFE_TrashSema", 0, 0, 1, nullptr);
+        if (gKfeTrash.semId < 0) return;
+        gKfeTrash.threadId = sceKernelCreateThread("KFE_Trash", KfeTrashThread, 0x40 /* below everything else */, 0x10000, 0, nullptr);
+        if (gKfeTrash.threadId < 0) return;
+        sceKernelStartThread(gKfeTrash.threadId, 0, nullptr);
+    }
+    gKfeTrash.pending = 1;
+    sceKernelSignalSema(gKfeTrash.semId, 1);
+}
+
+
 
 
 #ifndef PSP_UTILITY_OSK_RESULT_OK
@@ -578,13 +1364,13 @@ static const char* rootDisplayName(const char* r) {
 static bool startsWithCAT(const char* name) {
     return name && name[0]=='C' && name[1]=='A' && name[2]=='T' && name[3]=='_';
 }
-static char toLowerC(char c){ return (c>='A'&&c<='Z')? (c-'A'+'a') : c; }
 static bool endsWithNoCase(const std::string& s, const char* ext){
     size_t n = s.size(), m = strlen(ext);
     if (m>n) return false;
     for (size_t i=0;i<m;i++){ if (toLowerC(s[n-m+i]) != toLowerC(ext[i])) return false; }
     return true;
 }
+
 static bool isIsoLike(const std::string& n){
     return endsWithNoCase(n, ".iso") || endsWithNoCase(n, ".cso") ||
            endsWithNoCase(n, ".zso") || endsWithNoCase(n, ".dax") ||
@@ -652,6 +1438,12 @@ static bool isJunkHidden(const char* n) {
 static std::string findEbootCaseInsensitive(const std::string& dirMaybeSlash){
     std::string dpath = dirMaybeSlash;
     if (!dpath.empty() && dpath[dpath.size()-1]=='/') dpath.erase(dpath.size()-1);
+    if (const KfeDirListing* L = kfeDirCacheListing(dpath)) {
+        const KfeDirCacheEntry* e = kfeDirCacheFind(*L, "EBOOT.PBP", KFE_DC_FILE);
+        if (!e) e = kfeDirCacheFind(*L, "PBOOT.PBP", KFE_DC_FILE);
+        if (!e) e = kfeDirCacheFind(*L, "PARAM.PBP", KFE_DC_FILE);
+        return e ? joinDirFile(dpath, e->name.c_str()) : std::string();
+    }
     SceUID d = kfeIoOpenDir(dpath.c_str());
     if (d < 0) return {};
     SceIoDirent ent; memset(&ent, 0, sizeof(ent));
@@ -674,6 +1466,187 @@ static std::string findEbootCaseInsensitive(const std::string& dirMaybeSlash){
     return param;
 }
 
+// --- per-device category topology ---
+// Immediate subfolders of every category root on a device, with their
+// CAT_/XX parse, game-or-category classification and mtime. Built on first
+// use while a KfeCatTopoScope is open (one Game Categories operation), so
+// enforcement, refreshes, counts and mtime sorting share one listing per
+// root. Renames/rmdirs through the kfeIo* wrappers patch it in place; other
+// changes to a root's folder set drop it so the next lookup re-lists.
+struct KfeCatFolder {
+    std::string name;       // on-disk spelling
+    bool        hasCat;     // "CAT_" prefix
+    int         num;        // XX after the optional CAT_ (0 = none)
+    signed char isGame;     // folder itself holds a PBP; -1 = not probed yet
+    u64         mtime;      // RTC tick
+};
+struct KfeCatRoot {
+    std::string key;        // folded absolute path, no trailing '/'
+    std::vector<KfeCatFolder> folders;
+};
+struct KfeCatTopology { std::vector<KfeCatRoot> roots; };
+
+static const char* const kKfeCatRoots[] = {"ISO/","PSP/GAME/","PSP/GAME/PSX/","PSP/GAME/Utility/","PSP/GAME150/"};
+static int gKfeCatTopoDepth = 0;
+static std::unordered_map<std::string, KfeCatTopology> gKfeCatTopo;   // folded "ms0:/" -> topology
+
+static void kfeCatFolderParse(KfeCatFolder& f) {
+    const char* s = f.name.c_str();
+    f.hasCat = startsWithCAT(s);
+    if (f.hasCat) s += 4;
+    f.num = (s[0] >= '0' && s[0] <= '9' && s[1] >= '0' && s[1] <= '9') ? (s[0]-'0')*10 + (s[1]-'0') : 0;
+}
+
+static std::string kfeCatTopoDevKey(const std::string& path) {
+    size_t c = path.find(':');
+    if (c == std::string::npos) return std::string();
+    return kfeFoldCase(path.substr(0, c + 1).c_str()) + "/";
+}
+
+static KfeCatTopology* kfeCatTopology(const std::string& anyPath, bool build = true) {
+    if (gKfeCatTopoDepth <= 0) return nullptr;
+    const std::string dev = kfeCatTopoDevKey(anyPath);
+    if (dev.empty()) return nullptr;
+    auto it = gKfeCatTopo.find(dev);
+    if (it != gKfeCatTopo.end()) return &it->second;
+    if (!build) return nullptr;
+
+    KfeCatTopology& T = gKfeCatTopo[dev];
+    for (const char* rel : kKfeCatRoots) {
+        KfeCatRoot R;
+        R.key = kfeDirCacheKey(dev + rel);
+        KfeDirReader rd(R.key.c_str());
+        SceIoDirent ent;
+        while (rd.ok() && rd.next(ent)) {
+            trimTrailingSpaces(ent.d_name);
+            if (!FIO_S_ISDIR(ent.d_stat.st_mode)) continue;
+            if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..") || isJunkHidden(ent.d_name)) continue;
+            KfeCatFolder f;
+            f.name = ent.d_name;
+            kfeCatFolderParse(f);
+            f.isGame = -1;
+            f.mtime = 0;
+            sceRtcGetTick(&ent.d_stat.sce_st_mtime, &f.mtime);
+            R.folders.push_back(f);
+        }
+        T.roots.push_back(std::move(R));
+    }
+    return &T;
+}
+
+static KfeCatRoot* kfeCatTopoRoot(const std::string& absRoot, bool build = true) {
+    KfeCatTopology* T = kfeCatTopology(absRoot, build);
+    if (!T) return nullptr;
+    const std::string key = kfeDirCacheKey(absRoot);
+    for (auto& R : T->roots) if (R.key == key) return &R;
+    return nullptr;
+}
+static KfeCatFolder* kfeCatTopoFolderIn(KfeCatRoot& R, const std::string& sub) {
+    for (auto& f : R.folders) if (!strcasecmp(f.name.c_str(), sub.c_str())) return &f;
+    return nullptr;
+}
+
+// -1 = no topology for absRoot (caller hits the disk), 0 = no such folder, 1 = found.
+static int kfeCatTopoLookup(const std::string& absRoot, const std::string& sub,
+                            KfeCatFolder** out = nullptr, bool build = true) {
+    KfeCatRoot* R = kfeCatTopoRoot(absRoot, build);
+    if (!R) return -1;
+    KfeCatFolder* f = kfeCatTopoFolderIn(*R, sub);
+    if (out) *out = f;
+    return f ? 1 : 0;
+}
+
+// Immediate subfolders of a category root (appended); false when not covered.
+static bool kfeCatTopoSubdirs(const std::string& absRoot, std::vector<std::string>& out) {
+    KfeCatRoot* R = kfeCatTopoRoot(absRoot);
+    if (!R) return false;
+    for (const auto& f : R->folders) out.push_back(f.name);
+    return true;
+}
+
+// True if <absRoot>/<sub> is itself a game folder (holds EBOOT/PBOOT/PARAM).
+static bool kfeIsGameFolderIn(const std::string& absRoot, const std::string& sub) {
+    KfeCatFolder* f = nullptr;
+    if (kfeCatTopoLookup(absRoot, sub, &f) == 1) {
+        if (f->isGame < 0) f->isGame = findEbootCaseInsensitive(joinDirFile(absRoot, f->name.c_str())).empty() ? 0 : 1;
+        return f->isGame != 0;
+    }
+    return !findEbootCaseInsensitive(joinDirFile(absRoot, sub.c_str())).empty();
+}
+
+// Splits a path into folded parent key and on-disk leaf.
+static void kfeCatTopoSplit(const std::string& path, std::string& parentKey, std::string& leaf) {
+    std::string p = path;
+    while (p.size() > 5 && p.back() == '/') p.pop_back();
+    parentKey = kfeDirCacheKey(dirnameOf(p));
+    leaf = basenameOf(p);
+}
+
+static void kfeCatTopoTouched(const std::string& path, bool folderChange) {
+    if (gKfeCatTopoDepth <= 0 || gKfeCatTopo.empty()) return;
+    auto it = gKfeCatTopo.find(kfeCatTopoDevKey(path));
+    if (it == gKfeCatTopo.end()) return;
+    std::string parentKey, leaf;
+    kfeCatTopoSplit(path, parentKey, leaf);
+    for (auto& R : it->second.roots) {
+        if (folderChange && R.key == parentKey) { gKfeCatTopo.erase(it); return; }   // folder set changed
+    }
+    // Something inside <root>/<folder> changed: its game/category call may flip.
+    std::string grandKey, folder;
+    kfeCatTopoSplit(dirnameOf(path), grandKey, folder);
+    for (auto& R : it->second.roots) {
+        if (R.key != grandKey) continue;
+        if (KfeCatFolder* f = kfeCatTopoFolderIn(R, folder)) f->isGame = -1;
+    }
+}
+
+static void kfeCatTopoOnRemove(const std::string& path) {
+    if (gKfeCatTopoDepth <= 0 || gKfeCatTopo.empty()) return;
+    std::string parentKey, leaf;
+    kfeCatTopoSplit(path, parentKey, leaf);
+    bool patched = false;
+    if (KfeCatRoot* R = kfeCatTopoRoot(parentKey, false)) {
+        for (size_t i = 0; i < R->folders.size(); ++i) {
+            if (strcasecmp(R->folders[i].name.c_str(), leaf.c_str())) continue;
+            R->folders.erase(R->folders.begin() + i);
+            patched = true;
+            break;
+        }
+    }
+    if (!patched) kfeCatTopoTouched(path, false);
+}
+
+static void kfeCatTopoOnRename(const std::string& from, const std::string& to) {
+    if (gKfeCatTopoDepth <= 0 || gKfeCatTopo.empty()) return;
+    std::string fromParent, fromLeaf, toParent, toLeaf;
+    kfeCatTopoSplit(from, fromParent, fromLeaf);
+    kfeCatTopoSplit(to, toParent, toLeaf);
+    if (fromParent == toParent) {
+        KfeCatFolder* f = nullptr;
+        if (kfeCatTopoLookup(fromParent, fromLeaf, &f, false) == 1) {
+            f->name = toLeaf;        // FAT keeps the folder's mtime across a rename
+            kfeCatFolderParse(*f);
+            return;
+        }
+    }
+    kfeCatTopoTouched(from, true);
+    kfeCatTopoTouched(to, true);
+}
+
+// RAII: one Game Categories operation. Nested scopes share the topology.
+struct KfeCatTopoScope {
+    bool active = true;
+    KfeCatTopoScope() { ++gKfeCatTopoDepth; }
+    ~KfeCatTopoScope() { end(); }
+    void end() {
+        if (!active) return;
+        active = false;
+        if (--gKfeCatTopoDepth == 0) gKfeCatTopo.clear();
+    }
+    KfeCatTopoScope(const KfeCatTopoScope&) = delete;
+    KfeCatTopoScope& operator=(const KfeCatTopoScope&) = delete;
+};
+
 // Legacy-style date string
 static std::string buildLegacySortKey(const ScePspDateTime& dt){
     unsigned y  = (dt.year  < 0) ? 0u : (dt.year  > 9999 ? 9999u : (unsigned)dt.year);
@@ -704,6 +1677,10 @@ static u64 categoryFolderMtime(const std::string& dev, const std::string& catNam
     const char* roots[] = {"PSP/GAME/","PSP/GAME150/","PSP/GAME/PSX/","PSP/GAME/Utility/","ISO/"};
     SceIoStat st{}; 
     for (auto r : roots) {
+        KfeCatFolder* f = nullptr;
+        const int hit = kfeCatTopoLookup(dev + std::string(r), catName, &f);
+        if (hit == 1) return f->mtime;
+        if (hit == 0) continue;
         std::string p = dev + std::string(r) + catName;
         if (sceIoGetstat(p.c_str(), &st) >= 0 && FIO_S_ISDIR(st.st_mode)) {
             u64 t = 0;
@@ -719,17 +1696,15 @@ template<typename F>
 static void forEachEntry(const std::string& dir, F f){
     std::string dpath = dir;
     if (!dpath.empty() && dpath[dpath.size()-1]=='/') dpath.erase(dpath.size()-1);
-    SceUID d = kfeIoOpenDir(dpath.c_str());
-    if (d < 0) return;
-    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-    while (kfeIoReadDir(d, &ent) > 0) {
+    KfeDirReader rd(dpath.c_str());
+    if (!rd.ok()) return;
+    SceIoDirent ent;
+    while (rd.next(ent)) {
         trimTrailingSpaces(ent.d_name);
-        if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) { memset(&ent,0,sizeof(ent)); continue; }
-        if (isJunkHidden(ent.d_name))                                 { memset(&ent,0,sizeof(ent)); continue; }
+        if (!strcmp(ent.d_name, ".") || !strcmp(ent.d_name, "..")) continue;
+        if (isJunkHidden(ent.d_name))                                 continue;
         f(ent);
-        memset(&ent, 0, sizeof(ent));
     }
-    kfeIoCloseDir(d);
 }
 
 struct AnimFileInfo {
@@ -1463,20 +2438,8 @@ bool sfoExtractTitle(const uint8_t* data, size_t size, std::string& outTitle) {
 static std::string findFileCaseInsensitive(const std::string& dirNoSlash, const char* wantName) {
     std::string dpath = dirNoSlash;
     if (!dpath.empty() && dpath.back() == '/') dpath.pop_back();
-    SceUID d = kfeIoOpenDir(dpath.c_str());
-    if (d < 0) return {};
-    SceIoDirent ent; memset(&ent, 0, sizeof(ent));
-    std::string out;
-    while (kfeIoReadDir(d, &ent) > 0) {
-        trimTrailingSpaces(ent.d_name);
-        if (!FIO_S_ISDIR(ent.d_stat.st_mode) && strcasecmp(ent.d_name, wantName) == 0) {
-            out = joinDirFile(dpath, ent.d_name);
-            break;
-        }
-        memset(&ent, 0, sizeof(ent));
-    }
-    kfeIoCloseDir(d);
-    return out;
+    std::string name = kfeFindNameCaseInsensitive(dpath, wantName, KFE_DC_FILE);
+    return name.empty() ? name : joinDirFile(dpath, name.c_str());
 }
 
 static bool folderHasPbpNamed(const std::string& dirNoSlash, const char* name) {
@@ -1657,10 +2620,16 @@ static int countGamesInCategory(const std::string& device, const std::string& ca
 
     int count = 0;
 
+    // Category folder present? (topology when an operation has one open)
+    auto catPresent = [&](const char* r, const std::string& base){
+        const int hit = kfeCatTopoLookup(device + std::string(r), cat);
+        return hit < 0 ? dirExists(base) : hit == 1;
+    };
+
     // ISO-like files
     for (auto r : isoRoots) {
         std::string base = device + std::string(r) + cat + "/";
-        if (!dirExists(base)) continue;
+        if (!catPresent(r, base)) continue;
         forEachEntry(base, [&](const SceIoDirent& e){
             if (!FIO_S_ISDIR(e.d_stat.st_mode)) {
 
@@ -1673,7 +2642,7 @@ static int countGamesInCategory(const std::string& device, const std::string& ca
     // EBOOT folders (only immediate children of the category directory)
     for (auto r : gameRoots) {
         std::string base = device + std::string(r) + cat + "/";
-        if (!dirExists(base)) continue;
+        if (!catPresent(r, base)) continue;
         forEachEntry(base, [&](const SceIoDirent& e){
             if (FIO_S_ISDIR(e.d_stat.st_mode)) {
                 std::string child = base + e.d_name;
@@ -1816,15 +2785,424 @@ static void fillEbootIconPaths(GameItem& gi) {
     }
 }
 
+// Per-item metadata shared by the device scanners and the background prefetcher.
+static GameItem makeIsoGameItem(const std::string& dir, const std::string& fn) {
+    GameItem gi; gi.kind = GameItem::ISO_FILE;
+    gi.label = fn;
+    gi.path  = joinDirFile(dir, fn.c_str());
+    SceIoStat st{};
+    if (sceIoGetstat(gi.path.c_str(), &st) >= 0) {
+        gi.time     = st.sce_st_ctime;
+        gi.sortKey  = buildLegacySortKey(gi.time);
+        gi.sizeBytes= (uint64_t)st.st_size;
+    }
+
+    if (endsWithNoCase(fn, ".iso")) {
+        std::string t; if (readIsoTitle(gi.path, t)) gi.title = t;
+    } else if (endsWithNoCase(fn, ".cso") || endsWithNoCase(fn, ".zso")) {
+        std::string t; if (readCompressedIsoTitle(gi.path, t)) gi.title = t;
+    } else if (endsWithNoCase(fn, ".dax")) {
+        std::string t; if (readDaxTitle(gi.path, t)) gi.title = t;
+    } else if (endsWithNoCase(fn, ".jso")) {
+        std::string t; if (readJsoTitle(gi.path, t)) gi.title = t;
+    }
+    return gi;
+}
+
+static GameItem makeEbootGameItem(const std::string& folderNoSlash, const std::string& label) {
+    GameItem gi; gi.kind = GameItem::EBOOT_FOLDER;
+    gi.label = label;
+    gi.path  = folderNoSlash;
+    SceIoStat stF{};
+    if (sceIoGetstat(gi.path.c_str(), &stF) >= 0) {
+        gi.time     = stF.sce_st_mtime;
+        gi.sortKey  = buildLegacySortKey(gi.time);
+    }
+    // Folder size for the size column (can be O(total files))
+    uint64_t folderBytes = 0;
+    sumDirBytes(gi.path, folderBytes);
+    gi.sizeBytes = folderBytes;
+    gi.isUpdateDlc = isUpdateDlcFolder(gi.path);
+    fillEbootIconPaths(gi);
+
+    std::string t; if (getFolderTitle(gi.path, t)) gi.title = t;
+    return gi;
+}
+
+// ===== Background item prefetch for the second device (PSP Go) =====
+// While the root menu is up (or the user browses one device), a low-priority
+// worker walks the other device's ISO/ and PSP/GAME*/ roots and precomputes the
+// expensive per-item fields (stat, folder size, title, icon/PBP paths). ms0 and
+// ef0 sit on independent controllers, so this overlaps with main-thread I/O.
+// scanDevice() still enumerates folders itself (blacklist, renames and sorting
+// stay on the main thread) but takes finished items from here.
+struct DevPrefetch {
+    SceUID threadId = -1;
+    SceUID wakeSema = -1;
+    SceUID lockSema = -1;           // binary semaphore guarding the fields below
+    volatile int running = 0;
+    volatile int cancel  = 0;       // abandon the current device walk
+    volatile int busy    = 0;       // worker is touching the filesystem
+
+    std::vector<std::string> queue;                  // device roots still to walk
+    std::string current;                             // root being walked
+    std::unordered_map<std::string, GameItem> items; // folded item path -> finished item
+};
+static DevPrefetch gDPF;
+
+static void DevPrefetchLock()   { if (gDPF.lockSema >= 0) sceKernelWaitSema(gDPF.lockSema, 1, nullptr); }
+static void DevPrefetchUnlock() { if (gDPF.lockSema >= 0) sceKernelSignalSema(gDPF.lockSema, 1); }
+
+static void DevPrefetchPut(const GameItem& gi) {
+    DevPrefetchLock();
+    if (!gDPF.cancel) gDPF.items[kfeFoldCase(gi.path.c_str())] = gi;
+    DevPrefetchUnlock();
+}
+
+static void DevPrefetchWalk(const std::string& dev) {
+    // Only walk when the kernel bridge serves this device: off the UI thread
+    // there is no user-mode fallback (see kfeIoOpenDir).
+    SceUID probe = pspIoOpenDir(dev.c_str());
+    if (probe < 0) return;
+    pspIoCloseDir(probe);
+
+    const unsigned long long t0 = nowUS();
+    int count = 0;
+
+    const std::string isoBase = dev + "ISO/";
+    forEachEntry(isoBase, [&](const SceIoDirent& e){
+        if (gDPF.cancel) return;
+        std::string name = e.d_name;
+        if (FIO_S_ISDIR(e.d_stat.st_mode)) {
+            std::string catDir = isoBase + name;
+            forEachEntry(catDir, [&](const SceIoDirent& ee){
+                if (gDPF.cancel || FIO_S_ISDIR(ee.d_stat.st_mode) || !isIsoLike(ee.d_name)) return;
+                DevPrefetchPut(makeIsoGameItem(catDir, ee.d_name)); ++count;
+                sceKernelDelayThread(0);
+            });
+        } else if (isIsoLike(name)) {
+            DevPrefetchPut(makeIsoGameItem(isoBase, name)); ++count;
+            sceKernelDelayThread(0);
+        }
+    });
+
+    const char* gameRoots[] = {"PSP/GAME/","PSP/GAME/PSX/","PSP/GAME/Utility/","PSP/GAME150/"};
+    for (size_t i = 0; i < sizeof(gameRoots)/sizeof(gameRoots[0]) && !gDPF.cancel; ++i) {
+        const std::string base = dev + gameRoots[i];
+        forEachEntry(base, [&](const SceIoDirent& e){
+            if (gDPF.cancel || !FIO_S_ISDIR(e.d_stat.st_mode)) return;
+            std::string folder = joinDirFile(base, e.d_name);
+            if (!findEbootCaseInsensitive(folder).empty()) {
+                DevPrefetchPut(makeEbootGameItem(folder, e.d_name)); ++count;
+                sceKernelDelayThread(0);
+                return;
+            }
+            forEachEntry(folder, [&](const SceIoDirent& sub){
+                if (gDPF.cancel || !FIO_S_ISDIR(sub.d_stat.st_mode)) return;
+                std::string game = joinDirFile(folder, sub.d_name);
+                if (findEbootCaseInsensitive(game).empty()) return;
+                DevPrefetchPut(makeEbootGameItem(game, sub.d_name)); ++count;
+                sceKernelDelayThread(0);
+            });
+        });
+    }
+    logf("prefetch: %s %s, %d items in %llu ms", dev.c_str(), gDPF.cancel ? "canceled" : "done",
+         count, (nowUS() - t0) / 1000ULL);
+}
+
+static int DevPrefetchThread(SceSize, void*) {
+    while (gDPF.running) {
+        std::string dev;
+        DevPrefetchLock();
+        if (!gDPF.queue.empty()) {
+            dev = gDPF.queue.front();
+            gDPF.queue.erase(gDPF.queue.begin());
+            gDPF.current = dev;
+            gDPF.cancel = 0;
+            gDPF.busy = 1;
+        }
+        DevPrefetchUnlock();
+
+        if (dev.empty()) { sceKernelWaitSema(gDPF.wakeSema, 1, nullptr); continue; }
+
+        DevPrefetchWalk(dev);
+
+        DevPrefetchLock();
+        gDPF.current.clear();
+        gDPF.busy = 0;
+        DevPrefetchUnlock();
+    }
+    return 0;
+}
+
+static void DevPrefetchInit() {
+    if (gDPF.threadId >= 0) return;
+    gDPF.lockSema = sceKernelCreateSema("DPF_Lock", 0, 1, 1, nullptr);
+    gDPF.wakeSema = sceKernelCreateSema("DPF_Wake", 0, 0, 1, nullptr);
+    if (gDPF.lockSema < 0 || gDPF.wakeSema < 0) return;
+    gDPF.running = 1;
+    // Below the main thread: it only runs while the UI waits on vblank or I/O.
+    // Larger stack than the other workers: sumDirBytes recurses with a dirent per level.
+    gDPF.threadId = sceKernelCreateThread("DPF_Worker", DevPrefetchThread, 0x30, 0x10000, 0, nullptr);
+    if (gDPF.threadId >= 0) sceKernelStartThread(gDPF.threadId, 0, nullptr);
+    else gDPF.running = 0;
+}
+
+// Queue a device root ("ms0:/" / "ef0:/") for prefetch; no-op if already queued or walking.
+static void DevPrefetchKick(const std::string& dev) {
+    DevPrefetchInit();
+    if (gDPF.threadId < 0 || dev.empty()) return;
+    DevPrefetchLock();
+    bool known = !strcasecmp(gDPF.current.c_str(), dev.c_str());
+    for (const auto& q : gDPF.queue) if (!strcasecmp(q.c_str(), dev.c_str())) known = true;
+    if (!known) gDPF.queue.push_back(dev);
+    DevPrefetchUnlock();
+    sceKernelSignalSema(gDPF.wakeSema, 1);
+}
+
+// Main thread is about to scan dev itself: stop prefetching it, keep what's done.
+static void DevPrefetchClaim(const std::string& dev) {
+    if (gDPF.threadId < 0) return;
+    DevPrefetchLock();
+    for (size_t i = 0; i < gDPF.queue.size(); ) {
+        if (!strcasecmp(gDPF.queue[i].c_str(), dev.c_str())) gDPF.queue.erase(gDPF.queue.begin() + i);
+        else ++i;
+    }
+    if (!strcasecmp(gDPF.current.c_str(), dev.c_str())) gDPF.cancel = 1;
+    DevPrefetchUnlock();
+}
+
+// Move a finished item out of the prefetch store.
+static bool DevPrefetchTake(const std::string& path, GameItem& out) {
+    if (gDPF.threadId < 0) return false;
+    DevPrefetchLock();
+    auto it = gDPF.items.find(kfeFoldCase(path.c_str()));
+    const bool hit = (it != gDPF.items.end());
+    if (hit) { out = std::move(it->second); gDPF.items.erase(it); }
+    DevPrefetchUnlock();
+    return hit;
+}
+
+// Main thread finished scanning dev: leftovers would only go stale.
+static void DevPrefetchRelease(const std::string& dev) {
+    if (gDPF.threadId < 0) return;
+    const std::string key = kfeFoldCase(dev.c_str());
+    DevPrefetchLock();
+    for (auto it = gDPF.items.begin(); it != gDPF.items.end(); ) {
+        if (it->first.compare(0, key.size(), key) == 0) it = gDPF.items.erase(it);
+        else ++it;
+    }
+    DevPrefetchUnlock();
+}
+
+// Drop everything (file operations, USB mode). With wait=true, also block
+// until the worker has stopped touching the filesystem. The walk checks
+// cancel between items, so this lasts at most one item (one folder size sum).
+static void DevPrefetchReset(bool wait) {
+    if (gDPF.threadId < 0) return;
+    DevPrefetchLock();
+    gDPF.queue.clear();
+    gDPF.items.clear();
+    gDPF.cancel = 1;
+    DevPrefetchUnlock();
+    while (wait && gDPF.busy) sceKernelDelayThread(1000);
+}
+
+// ===== Boot: startup profile + background texture loader =====
+// Only what the root screen needs (background, root icons, button glyphs) is
+// decoded before the first frame. Everything else is queued in the order the
+// UI is likely to want it and decoded by a low-priority worker; the draw
+// helpers already skip null textures, so late icons simply pop in.
+struct KfeBootProfile {
+    unsigned long long t0 = 0;
+    unsigned long long firstFrameUs = 0;
+    volatile unsigned long long texDoneUs = 0;
+    volatile int texLoaded = 0;
+    bool texLogged = false;
+    bool deferredDone = false;
+    bool packLoaded = false;         // UI textures came from resources/ui_pack.bin
+    std::string animRoot;            // home/pop animations, scanned after the first frame
+};
+static KfeBootProfile gKfeBoot;
+
+static void kfeBootMark(const char* phase) {
+    const unsigned long long now = nowUS();
+    if (!gKfeBoot.t0) gKfeBoot.t0 = now;
+    logf("bootprof: %s +%llu ms", phase, (now - gKfeBoot.t0) / 1000ULL);
+}
+
+// ===== UI resource pack =====
+// resources/ui_pack.bin (format in kfe_ui_pack.h) holds every UI texture in
+// one RGBA8888 atlas, so boot does a single read instead of ~35 opens + PNG
+// inflates. It is built on the host by tools/mkuipack and shipped; the app
+// only reads it.
+struct KfeUiTex {
+    const char* file;        // under resources/
+    Texture**   slot;
+    bool        critical;    // needed for the first frame
+};
+#define KFE_UI_TEX_ENTRY(file, slot, critical) {file, &slot, critical},
+static const KfeUiTex kKfeUiTextures[] = { KFE_UI_TEXTURES(KFE_UI_TEX_ENTRY) };
+#undef KFE_UI_TEX_ENTRY
+static const size_t kKfeUiTextureCount = sizeof(kKfeUiTextures) / sizeof(kKfeUiTextures[0]);
+
+struct KfeResPack {
+    void* blob = nullptr;    // loaded pack; atlas sub-rect textures point into it
+    int packed = 0;          // slots filled from the atlas
+    int overridden = 0;      // pack entries replaced by a loose PNG
+};
+static KfeResPack gKfeResPack;
+
+// Fill texture slots from the pack. A loose PNG whose size differs from the
+// one the pack was built from wins over its entry; slots left null here go
+// through the loose path. False if the pack is missing or doesn't match.
+static bool kfeResPackLoad(const std::string& resDir) {
+    const std::string path = resDir + KFE_UI_PACK_FILE;
+    SceIoStat st{};
+    if (!pathExists(path, &st)) return false;
+    if (st.st_size < (SceOff)sizeof(KfeUiPackHeader) || st.st_size > 8 * 1024 * 1024) return false;
+
+    const size_t size = (size_t)st.st_size;
+    uint8_t* blob = (uint8_t*)memalign(64, size);
+    if (!blob) return false;
+    SceUID fd = sceIoOpen(path.c_str(), PSP_O_RDONLY, 0);
+    int rd = (fd >= 0) ? sceIoRead(fd, blob, (SceSize)size) : -1;
+    if (fd >= 0) sceIoClose(fd);
+
+    const KfeUiPackHeader* hdr = (const KfeUiPackHeader*)blob;
+    const size_t rectBytes = kKfeUiTextureCount * sizeof(KfeUiPackRect);
+    bool ok = rd == (int)size &&
+              hdr->magic == KFE_UI_PACK_MAGIC && hdr->version == KFE_UI_PACK_VERSION &&
+              hdr->count == kKfeUiTextureCount &&
+              hdr->atlasW == (uint32_t)KFE_UI_PACK_ATLAS_W && (hdr->dataOffset & 63) == 0 &&
+              hdr->dataOffset >= sizeof(KfeUiPackHeader) + rectBytes &&
+              (size_t)hdr->dataOffset + (size_t)hdr->atlasW * hdr->atlasH * 4 == size;
+    if (!ok) { free(blob); return false; }
+
+    // Loose PNG sizes from one directory read.
+    std::unordered_map<std::string, SceOff> loose;
+    SceUID d = sceIoDopen(resDir.c_str());
+    if (d >= 0) {
+        SceIoDirent e; memset(&e, 0, sizeof(e));
+        while (sceIoDread(d, &e) > 0) {
+            if (!FIO_S_ISDIR(e.d_stat.st_mode)) loose[kfeFoldCase(e.d_name)] = e.d_stat.st_size;
+            memset(&e, 0, sizeof(e));
+        }
+        sceIoDclose(d);
+    }
 
-// Verbose, unified "need" calculator for Move/Copy
+    const KfeUiPackRect* rects = (const KfeUiPackRect*)(blob + sizeof(KfeUiPackHeader));
+    uint32_t* atlas = (uint32_t*)(blob + hdr->dataOffset);
+    for (size_t i = 0; i < kKfeUiTextureCount; ++i) {
+        const KfeUiPackRect& r = rects[i];
+        if (r.w == 0 || (uint32_t)r.y + r.h > hdr->atlasH || (uint32_t)r.x + r.w > hdr->atlasW) continue;
+        auto it = loose.find(kfeFoldCase(kKfeUiTextures[i].file));
+        if (it != loose.end() && it->second != (SceOff)r.srcSize) { ++gKfeResPack.overridden; continue; }
+        *kKfeUiTextures[i].slot = texFromAtlas(atlas, (int)hdr->atlasW, r.x, r.y, r.w, r.h);
+        ++gKfeResPack.packed;
+    }
+    gKfeResPack.blob = blob;
+    return true;
+}
+
+struct KfeTexJob {
+    Texture** slot;
+    std::string path;
+};
+struct KfeTexLoader {
+    SceUID threadId = -1;
+    volatile int done = 0;
+    std::vector<KfeTexJob> jobs;     // filled before the worker starts, read-only afterwards
+};
+static KfeTexLoader gKfeTexLoader;
+
+static int KfeTexLoaderThread(SceSize, void*) {
+    for (const auto& j : gKfeTexLoader.jobs) {
+        *j.slot = texLoadPNG(j.path.c_str());
+        ++gKfeBoot.texLoaded;
+        kfeUiPoke();
+        sceKernelDelayThread(0);
+    }
+    // Only the OSK uses this; no reason to hold up the first frame for it.
+    if (backgroundTexture && backgroundTexture->data) {
+        gOskBgColorABGR = computeDominantColorABGRFromTexture(backgroundTexture);
+    }
+    gKfeBoot.texDoneUs = nowUS();
+    gKfeTexLoader.done = 1;
+    return 0;
+}
+
+static void kfeTexLoaderStart() {
+    // Below the main thread, like DPF_Worker; stbi's inflate wants a roomy stack.
+    gKfeTexLoader.threadId = sceKernelCreateThread("KFE_TexLoader", KfeTexLoaderThread, 0x30, 0x10000, 0, nullptr);
+    if (gKfeTexLoader.threadId >= 0) sceKernelStartThread(gKfeTexLoader.threadId, 0, nullptr);
+    else KfeTexLoaderThread(0, nullptr);
+}
+
+// Block until every queued texture is decoded (teardown).
+static void kfeTexLoaderWait() {
+    if (gKfeTexLoader.threadId < 0) return;
+    sceKernelWaitThreadEnd(gKfeTexLoader.threadId, nullptr);
+    sceKernelDeleteThread(gKfeTexLoader.threadId);
+    gKfeTexLoader.threadId = -1;
+}
+
+// Main-thread boot work that needs the filesystem (the kernel-bridge fallback
+// isn't thread-safe), run once the first frame is on screen.
+static void kfeBootDeferredInit() {
+    if (gKfeBoot.deferredDone) return;
+    gKfeBoot.deferredDone = true;
+    const std::string& animRoot = gKfeBoot.animRoot;
+
+    initHomeAnimations(animRoot);
+
+    if (gEnablePopAnimations && dirExists(animRoot)) {
+        bool prefUsed = false;
+        if (POP_ANIM_PREF && POP_ANIM_PREF[0]) {
+            std::string animDir = joinDirFile(animRoot, POP_ANIM_PREF);
+            if (dirExists(animDir)) {
+                gPopAnimDirs.push_back(animDir);
+                prefUsed = true;
+            }
+        }
+        if (!prefUsed) {
+            forEachEntry(animRoot, [&](const SceIoDirent& e){
+                if (FIO_S_ISDIR(e.d_stat.st_mode)) {
+                    gPopAnimDirs.push_back(joinDirFile(animRoot, e.d_name));
+                }
+            });
+        }
+        if (!gPopAnimDirs.empty()) shufflePopAnimOrder();
+    }
+    kfeBootMark("deferred init (animations)");
+
+    // Finish a trash purge an earlier session didn't get to.
+    SceIoStat st{};
+    if (sceIoGetstat((std::string("ms0:/") + KFE_TRASH_DIR).c_str(), &st) >= 0 ||
+        sceIoGetstat((std::string("ef0:/") + KFE_TRASH_DIR).c_str(), &st) >= 0) {
+        kfeTrashKick();
+    }
+}
+
+
+// Verbose, unified "need" calculator for Move/Copy. Sizes are what the
+// items will occupy on dstDev (cluster-rounded, directory tables included).
+// Stops early once need exceeds limit, so a hopeless target is rejected
+// without walking the rest of the selection.
 static uint64_t bytesNeededForOp(const std::vector<std::string>& srcPaths,
                                  const std::vector<GameItem::Kind>& kinds,
                                  const std::string& dstDev,
-                                 bool isCopy)
+                                 bool isCopy,
+                                 uint64_t limit = ~0ull)
 {
+    const uint32_t cluster = FreeSpaceClusterBytes(dstDev.c_str());
     uint64_t need = 0;
     for (size_t i = 0; i < srcPaths.size(); ++i) {
+        if (need > limit) {
+            logf("need: over limit %llu after %d/%d items; stopping",
+                 (unsigned long long)limit, (int)i, (int)srcPaths.size());
+            break;
+        }
         const bool sameDev = sameDevice(srcPaths[i], dstDev);
 
         // Move: same-device needs 0 extra space; Copy: counts regardless of device
@@ -1837,7 +3215,7 @@ static uint64_t bytesNeededForOp(const std::vector<std::string>& srcPaths,
         if (kinds[i] == GameItem::ISO_FILE) {
             SceIoStat st{};
             if (sceIoGetstat(srcPaths[i].c_str(), &st) >= 0) {
-                need += (uint64_t)st.st_size;
+                need += kfeRoundCluster((uint64_t)st.st_size, cluster);
                 logf("need: ISO %s size=%llu total=%llu",
                      srcPaths[i].c_str(),
                      (unsigned long long)st.st_size,
@@ -1847,7 +3225,7 @@ static uint64_t bytesNeededForOp(const std::vector<std::string>& srcPaths,
             }
         } else {
             uint64_t before = need;
-            if (!sumDirBytes(srcPaths[i], need)) {
+            if (!sumDirAlloc(srcPaths[i], cluster, need)) {
                 logf("need: DIR %s sum FAIL", srcPaths[i].c_str());
             } else {
                 logf("need: DIR %s added=%llu total=%llu",
@@ -1857,8 +3235,8 @@ static uint64_t bytesNeededForOp(const std::vector<std::string>& srcPaths,
             }
         }
     }
-    logf("need: FINAL need=%llu for dstDev=%s (mode=%s)",
-         (unsigned long long)need, dstDev.c_str(), isCopy ? "COPY" : "MOVE");
+    logf("need: FINAL need=%llu for dstDev=%s (mode=%s, cluster=%u)",
+         (unsigned long long)need, dstDev.c_str(), isCopy ? "COPY" : "MOVE", (unsigned)cluster);
     return need;
 }
 
@@ -1871,6 +3249,7 @@ uint64_t bytesNeededForMove(const std::vector<std::string>& srcPaths,
 }
 
 class KernelFileExplorer;
+struct KfeDirCopyCtx;
 
 struct KfeFileOps {
     static void resetCriticalGuardFailure() ;
@@ -1879,9 +3258,12 @@ struct KfeFileOps {
     static bool ensureDir(const std::string& path) ;
     static bool ensureDirRecursive(const std::string& full) ;
     static bool isDirectoryPath(const std::string& path) ;
+    static bool verifyCopy(const std::string& dst, uint32_t expectCrc, uint64_t expectSize,
+                           uint8_t* buf, size_t bufSize, KernelFileExplorer* self) ;
     static bool copyFile(const std::string& src, const std::string& dst, KernelFileExplorer* self) ;
     static bool removeDirRecursive(const std::string& dir) ;
     static bool copyDirRecursive(const std::string& src, const std::string& dst, KernelFileExplorer* self) ;
+    static bool copyDirWalk(const std::string& src, const std::string& dst, KernelFileExplorer* self, KfeDirCopyCtx& ctx) ;
     static std::string subrootFor(const std::string& path, GameItem::Kind kind) ;
     static bool parseCategoryFromPath(const std::string& pathAfterSubroot, std::string& outCat, std::string& outLeaf) ;
     static std::string afterSubroot(const std::string& full, const std::string& subroot) ;
@@ -0,0 +1,132 @@
+// Host test for the category rename planner (include/kfe_cat_plan.h).
+//   make host-tests
+#include <stdio.h>
+#include <algorithm>
+
+#include "kfe_cat_plan.h"
+
+static int gFailures = 0;
+#define CHECK(cond) do { if (!(cond)) { ++gFailures; fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); } } while (0)
+
+static KfeCatRootListing root(const char* absRoot,
+                              std::initializer_list<std::pair<const char*, const char*>> subs) {
+    KfeCatRootListing L;
+    L.absRoot = absRoot;
+    for (const auto& s : subs) { L.subs.push_back(s.first); L.bases.push_back(s.second); }
+    return L;
+}
+
+// Applies the plan to the listing the way enforceCategoryNames would and
+// returns the final folder names. Fails the test if a rename would land on
+// an existing folder or a step names a folder that isn't there.
+static std::vector<std::string> apply(const KfeCatRootListing& L, const std::vector<KfeCatPlanStep>& plan) {
+    std::vector<std::string> names = L.subs;
+    auto find = [&names](const std::string& n) {
+        for (size_t i = 0; i < names.size(); ++i) if (!strcasecmp(names[i].c_str(), n.c_str())) return (int)i;
+        return -1;
+    };
+    for (const auto& st : plan) {
+        if (st.absRoot != L.absRoot) continue;
+        const int from = find(st.from);
+        CHECK(from >= 0);
+        if (from < 0) continue;
+        if (st.kind == KfeCatPlanStep::Rename) {
+            CHECK(find(st.to) < 0);
+            names[from] = st.to;
+        } else {
+            CHECK(find(st.to) >= 0);
+            names.erase(names.begin() + from);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+static std::vector<std::string> sorted(std::initializer_list<const char*> v) {
+    std::vector<std::string> out(v.begin(), v.end());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+static void testRenameAndAlreadyCorrect() {
+    std::vector<KfeCatRootListing> roots;
+    roots.push_back(root("ms0:/PSP/GAME/", {{"CAT_01Games", "games"}, {"CAT_02Apps", "apps"}}));
+    KfeCatWantList wants = {{"Apps", "CAT_01Apps"}, {"Games", "CAT_02Games"}};
+    std::vector<KfeCatPlanStep> plan;
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(plan.size() == 2);
+    CHECK(apply(roots[0], plan) == sorted({"CAT_01Apps", "CAT_02Games"}));
+
+    // Nothing to do once the names match (case-only differences included).
+    std::vector<KfeCatRootListing> done;
+    done.push_back(root("ms0:/ISO/", {{"cat_01apps", "apps"}, {"CAT_02Games", "games"}}));
+    plan.clear();
+    kfePlanCategoryRenames(done, wants, plan);
+    CHECK(plan.empty());
+}
+
+static void testSwapNeedsTemporary() {
+    // Two categories trade numbers; neither target exists yet.
+    std::vector<KfeCatRootListing> roots;
+    roots.push_back(root("ms0:/PSP/GAME/", {{"01Apps", "apps"}, {"02Games", "games"}}));
+    KfeCatWantList wants = {{"apps", "02Apps"}, {"games", "01Games"}};
+    std::vector<KfeCatPlanStep> plan;
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(apply(roots[0], plan) == sorted({"01Games", "02Apps"}));
+
+    // A real cycle: the wanted names are exactly the current ones, swapped.
+    roots.clear();
+    roots.push_back(root("ms0:/PSP/GAME/", {{"Apps", "games"}, {"Games", "apps"}}));
+    wants = {{"apps", "Apps"}, {"games", "Games"}};
+    plan.clear();
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(plan.size() == 3);
+    CHECK(!plan.empty() && plan[0].to.compare(0, 8, "_KFE_TMP") == 0);
+    CHECK(apply(roots[0], plan) == sorted({"Apps", "Games"}));
+}
+
+static void testMergesAndGameFolders() {
+    std::vector<KfeCatRootListing> roots;
+    roots.push_back(root("ef0:/PSP/GAME/", {
+        {"CAT_Games", "games"},     // variant -> merged into the wanted name
+        {"Games", "games"},         // already the wanted name
+        {"03Games", "games"},       // another variant
+        {"Apps", ""},               // game folder that happens to share a base
+        {"Other", "other"},         // base nobody wants
+    }));
+    KfeCatWantList wants = {{"games", "Games"}, {"apps", "CAT_Apps"}};
+    std::vector<KfeCatPlanStep> plan;
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(plan.size() == 2);
+    for (const auto& st : plan) CHECK(st.kind == KfeCatPlanStep::Merge && st.to == "Games");
+    CHECK(apply(roots[0], plan) == sorted({"Apps", "Games", "Other"}));
+
+    // An unrelated folder already holding the wanted name is merged into.
+    roots.clear();
+    roots.push_back(root("ms0:/ISO/", {{"CAT_Games", "games"}, {"Games", ""}}));
+    wants = {{"games", "Games"}};
+    plan.clear();
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(plan.size() == 1 && plan[0].kind == KfeCatPlanStep::Merge);
+}
+
+static void testRootsPlannedIndependently() {
+    std::vector<KfeCatRootListing> roots;
+    roots.push_back(root("ms0:/ISO/", {{"Games", "games"}}));
+    roots.push_back(root("ms0:/PSP/GAME/", {{"CAT_Games", "games"}}));
+    KfeCatWantList wants = {{"games", "Games"}};
+    std::vector<KfeCatPlanStep> plan;
+    kfePlanCategoryRenames(roots, wants, plan);
+    CHECK(plan.size() == 1);
+    CHECK(!plan.empty() && plan[0].absRoot == "ms0:/PSP/GAME/" && plan[0].kind == KfeCatPlanStep::Rename);
+}
+
+int main() {
+    testRenameAndAlreadyCorrect();
+    testSwapNeedsTemporary();
+    testMergesAndGameFolders();
+    testRootsPlannedIndependently();
+    if (gFailures) { fprintf(stderr, "cat_plan_test: %d failure(s)\n", gFailures); return 1; }
+    printf("cat_plan_test: ok\n");
+    return 0;
+}
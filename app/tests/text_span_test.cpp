@@ -0,0 +1,127 @@
+// Host test for the text span cursors (include/kfe_text_span.h).
+//   make host-tests
+#include <stdio.h>
+#include <vector>
+
+#include "kfe_text_span.h"
+
+static int gFailures = 0;
+#define CHECK(cond) do { if (!(cond)) { ++gFailures; fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); } } while (0)
+
+static std::vector<std::string> lines(const std::string& text) {
+    std::vector<std::string> out;
+    KfeLineCursor cur(text);
+    KfeTextSpan line;
+    while (cur.next(line)) out.push_back(line.str());
+    return out;
+}
+
+static std::vector<std::string> fields(const std::string& line, char sep) {
+    std::vector<std::string> out;
+    KfeFieldCursor cur(KfeTextSpan(line), sep);
+    KfeTextSpan f;
+    while (cur.next(f)) out.push_back(f.str());
+    return out;
+}
+
+typedef std::vector<std::string> Strs;
+
+static void testLineEndings() {
+    CHECK(lines("a\r\nb\nc\rd") == Strs({"a", "b", "c", "d"}));
+    CHECK(lines("a\n\r\nb") == Strs({"a", "", "b"}));          // LF then CRLF: one empty line between
+    CHECK(lines("a\n\nb") == Strs({"a", "", "b"}));
+    CHECK(lines("a\r\rb") == Strs({"a", "", "b"}));
+    CHECK(lines("\r\n\r\n") == Strs({"", "", ""}));
+}
+
+static void testNoTrailingNewline() {
+    CHECK(lines("") == Strs({""}));
+    CHECK(lines("only") == Strs({"only"}));
+    CHECK(lines("x\ny") == Strs({"x", "y"}));
+    CHECK(lines("x\ny\n") == Strs({"x", "y", ""}));
+}
+
+static void testTruncatedBuffers() {
+    // A read that stopped mid-CRLF or mid-line must not run past the span.
+    const char buf[] = "first\r\nsecond line\r\nthird";
+    for (size_t n = 0; n <= sizeof(buf) - 1; ++n) {
+        std::vector<std::string> got;
+        KfeLineCursor cur(KfeTextSpan(buf, n));
+        KfeTextSpan line;
+        size_t total = 0;
+        while (cur.next(line)) {
+            CHECK(line.p >= buf && line.p + line.n <= buf + n);
+            got.push_back(line.str());
+            total += line.n;
+        }
+        CHECK(!got.empty());
+        CHECK(total <= n);
+    }
+    CHECK(lines(std::string("a\r", 2)) == Strs({"a", ""}));
+    CHECK(lines(std::string("a\0b", 3)) == Strs({std::string("a\0b", 3)}));   // NULs stay inside the line
+
+    // Spans over the middle of a buffer stop at their own end.
+    const std::string big = "keep\nthis\ndrop";
+    KfeTextSpan part = KfeTextSpan(big).sub(0, 7);      // "keep\nth"
+    std::vector<std::string> got;
+    KfeLineCursor cur(part);
+    KfeTextSpan line;
+    while (cur.next(line)) got.push_back(line.str());
+    CHECK(got == Strs({"keep", "th"}));
+    CHECK(KfeTextSpan(big).sub(100).empty());
+    CHECK(KfeTextSpan(big).sub(10, 100).str() == "drop");
+}
+
+static void testOversizedInput() {
+    // One 1 MiB line, then many short ones: nothing is clipped or dropped.
+    std::string text(1u << 20, 'x');
+    text += "\r\n";
+    for (int i = 0; i < 10000; ++i) text += (i & 1) ? "ab\n" : "cd\r\n";
+    KfeLineCursor cur(text);
+    KfeTextSpan line;
+    size_t count = 0;
+    bool ok = cur.next(line) && line.n == (1u << 20);
+    CHECK(ok);
+    while (cur.next(line)) {
+        if (count < 10000) CHECK(line.str() == ((count & 1) ? "ab" : "cd"));
+        ++count;
+    }
+    CHECK(count == 10001);   // the 10000 short lines plus the empty tail
+
+    std::string wide;
+    for (int i = 0; i < 5000; ++i) wide += "v,";
+    CHECK(fields(wide, ',').size() == 5001);
+}
+
+static void testFields() {
+    CHECK(fields(" ms0:/seplugins/a.prx , 1 ", ',') == Strs({"ms0:/seplugins/a.prx", "1"}));
+    CHECK(fields("a,", ',') == Strs({"a", ""}));          // trailing separator: one empty field
+    CHECK(fields("", ',') == Strs({""}));
+    CHECK(fields("  game   ms0:/x.prx\t1\r", 0) == Strs({"game", "ms0:/x.prx", "1"}));
+    CHECK(fields(" \t\r\n", 0).empty());
+}
+
+static void testHelpers() {
+    CHECK(kfeSpanTrim(KfeTextSpan(std::string(" \t x y \r\n"))).str() == "x y");
+    const std::string on = "ON";
+    CHECK(kfeSpanEqNoCase(KfeTextSpan(on), "on"));
+    CHECK(!kfeSpanEqNoCase(KfeTextSpan(on), "onx"));
+    const std::string path = "ms0:/SEPLUGINS/Category_Lite.prx";
+    CHECK(kfeSpanStartsNoCase(KfeTextSpan(path), "MS0:/seplugins"));
+    CHECK(kfeSpanContainsNoCase(KfeTextSpan(path), "category_lite"));
+    CHECK(!kfeSpanContainsNoCase(KfeTextSpan(path).sub(0, 20), "category_lite"));
+    CHECK(kfeSpanIsBlank('\r') && !kfeSpanIsBlank('x'));
+    CHECK(KfeTextSpan(path).find('/') == 4 && KfeTextSpan(path).find('#') == std::string::npos);
+}
+
+int main() {
+    testLineEndings();
+    testNoTrailingNewline();
+    testTruncatedBuffers();
+    testOversizedInput();
+    testFields();
+    testHelpers();
+    if (gFailures) { fprintf(stderr, "text_span_test: %d failure(s)\n", gFailures); return 1; }
+    printf("text_span_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Host tool: builds resources/ui_pack.bin from the loose UI PNGs.
+//   mkuipack <resources dir/> <out file>
+// Format and texture list live in include/kfe_ui_pack.h; the Makefile reruns
+// this whenever a PNG or that header changes.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "stb_image.h"
+
+#include "kfe_ui_pack.h"
+
+#define KFE_UI_PACK_NAME(file, slot, critical) file,
+static const char* kFiles[] = { KFE_UI_TEXTURES(KFE_UI_PACK_NAME) };
+#undef KFE_UI_PACK_NAME
+static const size_t kCount = sizeof(kFiles) / sizeof(kFiles[0]);
+
+struct Image {
+    int w = 0, h = 0;
+    unsigned char* px = nullptr;   // RGBA8888, tightly packed
+    uint32_t srcSize = 0;
+};
+
+static void put16(std::vector<unsigned char>& o, uint16_t v) {
+    o.push_back((unsigned char)v); o.push_back((unsigned char)(v >> 8));
+}
+static void put32(std::vector<unsigned char>& o, uint32_t v) {
+    for (int i = 0; i < 4; ++i) o.push_back((unsigned char)(v >> (8 * i)));
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <resources dir/> <out file>\n", argv[0]);
+        return 2;
+    }
+    std::string resDir = argv[1];
+    if (!resDir.empty() && resDir.back() != '/') resDir += '/';
+
+    std::vector<Image> imgs(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        const std::string p = resDir + kFiles[i];
+        FILE* f = fopen(p.c_str(), "rb");
+        if (!f) { fprintf(stderr, "mkuipack: %s missing, leaving it out\n", p.c_str()); continue; }
+        fseek(f, 0, SEEK_END);
+        imgs[i].srcSize = (uint32_t)ftell(f);
+        fclose(f);
+        int comp = 0;
+        imgs[i].px = stbi_load(p.c_str(), &imgs[i].w, &imgs[i].h, &comp, STBI_rgb_alpha);
+        if (!imgs[i].px) {
+            fprintf(stderr, "mkuipack: %s: %s\n", p.c_str(), stbi_failure_reason());
+            return 1;
+        }
+    }
+
+    // Shelf pack in table order. x stays a multiple of 4 (16 bytes) for
+    // texFromAtlas, and the gap stops linear filtering bleeding between icons.
+    const int W = KFE_UI_PACK_ATLAS_W;
+    const int gap = 4;
+    std::vector<KfeUiPackRect> rects(kCount);
+    int x = 0, y = 0, shelfH = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+        KfeUiPackRect& r = rects[i];
+        memset(&r, 0, sizeof(r));
+        r.srcSize = imgs[i].srcSize;
+        if (!imgs[i].px) continue;
+        if (imgs[i].w > W) { fprintf(stderr, "mkuipack: %s wider than %d\n", kFiles[i], W); return 1; }
+        if (x + imgs[i].w > W) { x = 0; y += shelfH + gap; shelfH = 0; }
+        r.x = (uint16_t)x; r.y = (uint16_t)y;
+        r.w = (uint16_t)imgs[i].w; r.h = (uint16_t)imgs[i].h;
+        x += ((imgs[i].w + 3) & ~3) + gap;
+        if (imgs[i].h > shelfH) shelfH = imgs[i].h;
+    }
+    const int H = y + shelfH;
+    if (H <= 0) { fprintf(stderr, "mkuipack: no textures\n"); return 1; }
+
+    const uint32_t dataOffset =
+        (uint32_t)((sizeof(KfeUiPackHeader) + kCount * sizeof(KfeUiPackRect) + 63) & ~(size_t)63);
+
+    std::vector<unsigned char> out;
+    put32(out, KFE_UI_PACK_MAGIC);
+    put32(out, KFE_UI_PACK_VERSION);
+    put32(out, (uint32_t)kCount);
+    put32(out, (uint32_t)W);
+    put32(out, (uint32_t)H);
+    put32(out, dataOffset);
+    put32(out, 0);
+    put32(out, 0);
+    for (size_t i = 0; i < kCount; ++i) {
+        put16(out, rects[i].x); put16(out, rects[i].y);
+        put16(out, rects[i].w); put16(out, rects[i].h);
+        put32(out, rects[i].srcSize);
+    }
+    out.resize(dataOffset + (size_t)W * H * 4, 0);
+    unsigned char* atlas = out.data() + dataOffset;
+    for (size_t i = 0; i < kCount; ++i) {
+        const KfeUiPackRect& r = rects[i];
+        if (!imgs[i].px) continue;
+        for (int row = 0; row < r.h; ++row) {
+            memcpy(atlas + ((size_t)(r.y + row) * W + r.x) * 4, imgs[i].px + (size_t)row * r.w * 4, (size_t)r.w * 4);
+        }
+        stbi_image_free(imgs[i].px);
+    }
+
+    const std::string tmp = std::string(argv[2]) + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) { perror(tmp.c_str()); return 1; }
+    const bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    if (fclose(f) != 0 || !ok || rename(tmp.c_str(), argv[2]) != 0) {
+        perror(argv[2]);
+        remove(tmp.c_str());
+        return 1;
+    }
+    printf("mkuipack: %s: %d textures, %dx%d atlas, %u bytes\n",
+           argv[2], (int)kCount, W, H, (unsigned)out.size());
+    return 0;
+}
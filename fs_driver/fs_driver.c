@@ -1,7 +1,9 @@
 #include <pspsdk.h>
 #include <pspiofilemgr_kernel.h>
 #include <pspsyscon.h>
+#include <pspsysmem_kernel.h>
 #include <pspthreadman.h>
+#include <string.h>
 
 #include "systemctrl.h"
 
@@ -30,6 +32,182 @@ int pspIoReadDir(SceUID dir, SceIoDirent *dirent) {
 	return ret;
 }
 
+// Compact directory entry for pspIoReadDirBatch (keep in sync with kfe_app_preamble.h).
+typedef struct {
+	SceMode mode;
+	SceOff size;
+	ScePspDateTime ctime;
+	ScePspDateTime mtime;
+	char name[256];
+} PspIoDirEntryLite;
+
+// Fill up to maxEntries compact entries in one kernel transition.
+// Skips "." and "..". Returns the count (0 at end of directory) or a
+// negative error if the very first read fails.
+int pspIoReadDirBatch(SceUID dir, PspIoDirEntryLite *out, int maxEntries) {
+	if (!out || maxEntries <= 0) return 0;
+
+	u32 k1 = pspSdkSetK1(0);
+	int level = sctrlKernelSetUserLevel(8);
+
+	SceIoDirent ent;
+	int n = 0;
+	int ret = 0;
+	while (n < maxEntries) {
+		memset(&ent, 0, sizeof(ent));
+		ret = sceIoDread(dir, &ent);
+		if (ret <= 0) break;
+		if (ent.d_name[0] == '.' && (ent.d_name[1] == '\0' ||
+		    (ent.d_name[1] == '.' && ent.d_name[2] == '\0'))) continue;
+
+		PspIoDirEntryLite *e = &out[n++];
+		e->mode = ent.d_stat.st_mode;
+		e->size = ent.d_stat.st_size;
+		e->ctime = ent.d_stat.sce_st_ctime;
+		e->mtime = ent.d_stat.sce_st_mtime;
+		strncpy(e->name, ent.d_name, sizeof(e->name) - 1);
+		e->name[sizeof(e->name) - 1] = '\0';
+	}
+
+	pspSdkSetK1(k1);
+	sctrlKernelSetUserLevel(level);
+	return (n == 0 && ret < 0) ? ret : n;
+}
+
+// Totals filled by pspIoWalkTree (keep in sync with kfe_app_preamble.h).
+typedef struct {
+	u64 bytes;
+	u32 files;
+	u32 dirs;
+	u32 manifestUsed;	// bytes written to the manifest buffer
+	u32 truncated;		// manifest ran out of room (totals are still complete)
+	u32 clusterBytes;	// in: cluster size for allocBytes (0 = skip)
+	u32 reserved;
+	u64 allocBytes;		// out: files rounded up to clusters plus directory tables
+} PspIoTreeStats;
+
+#define WALK_MAX_DEPTH 32
+#define WALK_PATH_MAX  512
+
+// Walk state lives on the kernel heap: the syscall runs on the caller's
+// small kernel stack, so no recursion and no big locals.
+typedef struct {
+	SceUID dirs[WALK_MAX_DEPTH];
+	int lens[WALK_MAX_DEPTH];	// path length at each level (without trailing '/')
+	u32 entBytes[WALK_MAX_DEPTH];	// FAT directory table bytes at each level
+	char path[WALK_PATH_MAX];
+	SceIoDirent ent;
+} WalkState;
+
+static void walkEmit(char *manifest, int manifestSize, PspIoTreeStats *st,
+		     char kind, const char *rel) {
+	if (!manifest || st->truncated) return;
+	int n = strlen(rel) + 2;
+	if ((int)st->manifestUsed + n > manifestSize) { st->truncated = 1; return; }
+	manifest[st->manifestUsed] = kind;
+	memcpy(manifest + st->manifestUsed + 1, rel, n - 1);
+	st->manifestUsed += n;
+}
+
+static u64 walkRoundUp(u64 n, u32 cluster) {
+	return (n + cluster - 1) / cluster * cluster;
+}
+
+// One FAT directory entry per name plus its long-name entries (13 chars each).
+static u32 walkDirEntBytes(int nameLen) {
+	return 32u * (1u + (u32)(nameLen + 12) / 13u);
+}
+
+// Iterative walk of everything below root in one kernel call.
+// Totals go to *stats. With stats->clusterBytes set on entry, allocBytes
+// estimates what the tree occupies on a volume with that cluster size.
+// When manifest is given, it receives packed records
+// "<kind><path relative to root>\0" with kind 'F' or 'D'; files come before
+// the folder that holds them and folders are emitted after their contents
+// (deepest first), so the manifest doubles as a delete order.
+// Returns 0, or a negative error if root or any subfolder can't be read.
+int pspIoWalkTree(const char *root, PspIoTreeStats *stats, char *manifest, int manifestSize) {
+	if (!root || !stats) return 0x80010016;	// EINVAL
+
+	u32 k1 = pspSdkSetK1(0);
+	int level = sctrlKernelSetUserLevel(8);
+
+	PspIoTreeStats st;
+	memset(&st, 0, sizeof(st));
+	st.clusterBytes = stats->clusterBytes;
+	const u32 cluster = st.clusterBytes;
+	int ret = 0;
+
+	SceUID blk = sceKernelAllocPartitionMemory(1, "fsdWalk", PSP_SMEM_Low, sizeof(WalkState), NULL);
+	WalkState *w = (blk >= 0) ? (WalkState *)sceKernelGetBlockHeadAddr(blk) : NULL;
+	if (!w) { ret = (blk < 0) ? blk : 0x80020190; goto out; }
+
+	int rootLen = strlen(root);
+	while (rootLen > 1 && root[rootLen - 1] == '/' && root[rootLen - 2] != ':') rootLen--;
+	if (rootLen == 0) { ret = 0x80010016; goto out; }
+	if (rootLen >= WALK_PATH_MAX - 1) { ret = 0x8001005B; goto out; }	// ENAMETOOLONG
+	memcpy(w->path, root, rootLen);
+	w->path[rootLen] = '\0';
+	int relStart = (w->path[rootLen - 1] == '/') ? rootLen : rootLen + 1;
+
+	int depth = 0;
+	w->dirs[0] = sceIoDopen(w->path);
+	w->lens[0] = rootLen;
+	w->entBytes[0] = 64;	// "." and ".."
+	if (w->dirs[0] < 0) { ret = w->dirs[0]; goto out; }
+
+	while (depth >= 0) {
+		memset(&w->ent, 0, sizeof(w->ent));
+		int r = sceIoDread(w->dirs[depth], &w->ent);
+		if (r <= 0) {
+			sceIoDclose(w->dirs[depth]);
+			if (r < 0 && ret == 0) ret = r;
+			if (cluster) st.allocBytes += walkRoundUp(w->entBytes[depth], cluster);
+			if (depth > 0) {
+				w->path[w->lens[depth]] = '\0';
+				walkEmit(manifest, manifestSize, &st, 'D', w->path + relStart);
+				st.dirs++;
+			}
+			depth--;
+			if (depth >= 0) w->path[w->lens[depth]] = '\0';
+			continue;
+		}
+		const char *nm = w->ent.d_name;
+		if (nm[0] == '.' && (nm[1] == '\0' || (nm[1] == '.' && nm[2] == '\0'))) continue;
+
+		int base = w->lens[depth];
+		int sep = (w->path[base - 1] == '/') ? 0 : 1;
+		int nlen = strlen(nm);
+		if (base + sep + nlen >= WALK_PATH_MAX) { if (ret == 0) ret = 0x8001005B; continue; }
+		if (sep) w->path[base] = '/';
+		memcpy(w->path + base + sep, nm, nlen + 1);
+		w->entBytes[depth] += walkDirEntBytes(nlen);
+
+		if (FIO_S_ISDIR(w->ent.d_stat.st_mode)) {
+			if (depth + 1 >= WALK_MAX_DEPTH) { if (ret == 0) ret = 0x8001005B; w->path[base] = '\0'; continue; }
+			SceUID d = sceIoDopen(w->path);
+			if (d < 0) { if (ret == 0) ret = d; w->path[base] = '\0'; continue; }
+			depth++;
+			w->dirs[depth] = d;
+			w->lens[depth] = base + sep + nlen;
+			w->entBytes[depth] = 64;
+		} else {
+			st.files++;
+			st.bytes += (u64)w->ent.d_stat.st_size;
+			if (cluster) st.allocBytes += walkRoundUp((u64)w->ent.d_stat.st_size, cluster);
+			walkEmit(manifest, manifestSize, &st, 'F', w->path + relStart);
+			w->path[base] = '\0';
+		}
+	}
+
+out:
+	if (blk >= 0) sceKernelFreePartitionMemory(blk);
+	memcpy(stats, &st, sizeof(st));
+	pspSdkSetK1(k1);
+	sctrlKernelSetUserLevel(level);
+	return ret;
+}
+
 int pspIoCloseDir(SceUID dir) {
 	u32 k1 = pspSdkSetK1(0);
 	int level = sctrlKernelSetUserLevel(8);